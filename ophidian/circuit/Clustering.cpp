@@ -0,0 +1,179 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Clustering.h"
+#include "Coarsening.h"
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <random>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+Clustering::Clustering(const Netlist & netlist, const Hypergraph & hypergraph, const std::vector<double> & weights, const ClusteringOptions & options, util::StringPool* names) :
+	mNetlist(util::defaultResource(), names),
+	mClusters(netlist.makeProperty<Cell>(Cell())),
+	mIndex(mNetlist.makeProperty<Index>(Cell())),
+	mWeights(mNetlist.makeProperty<double>(Cell())),
+	mNetWeights(mNetlist.makeProperty<std::uint32_t>(Net()))
+{
+	assert(weights.empty() || weights.size() == hypergraph.size(Cell()));
+	const auto cells = hypergraph.size(Cell());
+	const auto fine = weightedHypergraph(hypergraph, weights);
+	// the Nets of fine are the Nets of hypergraph with two Cells or more
+	std::vector<Index> fineNets;
+	fineNets.reserve(fine.nets());
+	for(Index net = 0; net < hypergraph.size(Net()); ++net)
+	{
+		if(hypergraph.cells(net).size() >= 2)
+		{
+			fineNets.push_back(net);
+		}
+	}
+
+	CoarseningOptions coarsening;
+	const double average = fine.totalWeight() / std::max<std::size_t>(cells, 1);
+	coarsening.maxClusterWeight = options.maxClusterWeight > 0.0 ? options.maxClusterWeight : 4.0 * average;
+	coarsening.maxNetDegree = options.maxNetDegree;
+	coarsening.matching = options.scheme == ClusteringOptions::Scheme::HeavyEdge;
+	coarsening.parallel = options.parallel;
+	std::mt19937 random(options.seed);
+	std::vector<Index> clusters;
+	std::vector<double> clusterWeights;
+	circuit::cluster(fine, coarsening, random, clusters, clusterWeights);
+
+	// clusters are numbered by their first Cell, so the clustered Netlist keeps the order of the original one
+	std::vector<Index> numbers(clusterWeights.size(), kNoIndex);
+	std::vector<Index> representatives;
+	std::vector<double> representativeWeights;
+	representatives.reserve(clusterWeights.size());
+	representativeWeights.reserve(clusterWeights.size());
+	for(Index cell = 0; cell < cells; ++cell)
+	{
+		auto & number = numbers[clusters[cell]];
+		if(number == kNoIndex)
+		{
+			number = representatives.size();
+			representatives.push_back(cell);
+			representativeWeights.push_back(clusterWeights[clusters[cell]]);
+		}
+		clusters[cell] = number;
+	}
+	mOffsets.assign(representatives.size() + 1, 0);
+	for(auto cluster : clusters)
+	{
+		++mOffsets[cluster + 1];
+	}
+	std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+	mMembers.resize(cells);
+	std::vector<Index> cursor(mOffsets.begin(), mOffsets.end() - 1);
+	for(Index cell = 0; cell < cells; ++cell)
+	{
+		mMembers[cursor[clusters[cell]]++] = hypergraph.cell(cell);
+	}
+
+	std::vector<Index> merged;
+	const auto coarse = contract(fine, clusters, representativeWeights, options.parallel, &merged);
+
+	// the clustered Netlist, named after the representatives
+	std::vector<std::string> cellNames;
+	cellNames.reserve(representatives.size());
+	for(auto cell : representatives)
+	{
+		cellNames.push_back(netlist.name(hypergraph.cell(cell)));
+	}
+	auto clusterCells = mNetlist.add(Cell(), cellNames);
+	cellNames = std::vector<std::string>();
+	for(Index cluster = 0; cluster < clusterCells.size(); ++cluster)
+	{
+		mIndex[clusterCells[cluster]] = cluster;
+		mWeights[clusterCells[cluster]] = representativeWeights[cluster];
+	}
+
+	// each coarse Net keeps, for each of its clusters, the first Pin of its representative Net in that cluster
+	std::vector<std::string> netNames;
+	std::vector<std::string> pinNames;
+	std::vector<Pin> pins(coarse.netCells.size());
+	Index coarseNet = 0;
+	for(Index net = 0; net < fine.nets(); ++net)
+	{
+		if(merged[net] != net)
+		{
+			continue;
+		}
+		const auto original = hypergraph.net(fineNets[net]);
+		netNames.push_back(netlist.name(original));
+		for(auto pin : netlist.pins(original))
+		{
+			auto cell = netlist.cell(pin);
+			if(cell == Cell())
+			{
+				continue;
+			}
+			auto position = std::lower_bound(coarse.begin(coarseNet), coarse.end(coarseNet), clusters[hypergraph.index(cell)]) - coarse.netCells.data();
+			if(pins[position] == Pin())
+			{
+				pins[position] = pin;
+			}
+		}
+		for(auto pin = pins.begin() + coarse.netOffsets[coarseNet]; pin != pins.begin() + coarse.netOffsets[coarseNet + 1]; ++pin)
+		{
+			pinNames.push_back(netlist.name(*pin));
+		}
+		++coarseNet;
+	}
+	auto clusterNets = mNetlist.add(Net(), netNames);
+	auto clusterPins = mNetlist.add(Pin(), pinNames);
+	netNames = std::vector<std::string>();
+	pinNames = std::vector<std::string>();
+	for(Index net = 0; net < coarse.nets(); ++net)
+	{
+		mNetWeights[clusterNets[net]] = coarse.netWeights[net];
+		for(auto incidence = coarse.netOffsets[net]; incidence < coarse.netOffsets[net + 1]; ++incidence)
+		{
+			mNetlist.add(clusterCells[coarse.netCells[incidence]], clusterPins[incidence]);
+			mNetlist.connect(clusterNets[net], clusterPins[incidence]);
+		}
+	}
+
+	entity_system::parallel_for_range(cells, [&](std::size_t first, std::size_t last) {
+		for(auto cell = first; cell < last; ++cell)
+		{
+			mClusters.begin()[cell] = clusterCells[clusters[cell]];
+		}
+	}, options.parallel);
+}
+
+util::MemoryUsage Clustering::memoryUsage() const
+{
+	util::MemoryUsage usage("Clustering", mMembers.size(), mMembers.capacity());
+	usage.add("netlist", mNetlist.memoryUsage());
+	usage.add("clusters", mClusters.memoryUsage());
+	usage.add("index", mIndex.memoryUsage());
+	usage.add("weights", mWeights.memoryUsage());
+	usage.add("netWeights", mNetWeights.memoryUsage());
+	usage.add("offsets", util::memoryUsage(mOffsets));
+	usage.add("members", util::memoryUsage(mMembers));
+	return usage;
+}
+
+} // namespace circuit
+} // namespace ophidian
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_CLUSTERING_H
+#define OPHIDIAN_CIRCUIT_CLUSTERING_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/circuit/Hypergraph.h>
+#include <ophidian/circuit/Netlist.h>
+#include <ophidian/entity_system/Parallel.h>
+#include <ophidian/util/Range.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Clustering options
+struct ClusteringOptions
+{
+	//! How Cells are grouped
+	enum class Scheme
+	{
+		//! Every Cell joins the cluster of its best neighbor, so clusters may grow beyond pairs
+		FirstChoice,
+		//! Cells are matched in pairs with their best neighbor, or with their best unmatched one when it was taken
+		HeavyEdge
+	};
+
+	//! Construct ClusteringOptions
+	/*!
+	   \param scheme How Cells are grouped.
+	   \param maxClusterWeight The maximum weight of a cluster, or 0 for four times the average weight of a Cell.
+	 */
+	ClusteringOptions(Scheme scheme = Scheme::FirstChoice, double maxClusterWeight = 0.0) :
+		scheme(scheme),
+		maxClusterWeight(maxClusterWeight)
+	{
+
+	}
+
+	Scheme scheme;
+	double maxClusterWeight;
+	//! Nets with more Cells are ignored when rating neighbors, but are still kept in the clustered Netlist
+	std::size_t maxNetDegree = 256;
+	//! Seed of the order in which Cells pick their clusters
+	std::uint32_t seed = 0;
+	//! Grain size and number of threads of the parallel steps
+	entity_system::ParallelOptions parallel;
+};
+
+//! Clustering of a Netlist
+/*!
+   Collapses a Netlist into a coarser Netlist whose Cells are clusters of strongly connected Cells, for multilevel (V-cycle) placement and partitioning.
+   Cells rate their neighbors in parallel by the Nets they share, divided by the size of those Nets and by the weight of the neighbor, and then pick their clusters in a random order fixed by the seed, so the result does not depend on the number of threads.
+   Each Net of the clustered Netlist merges the Nets that connect the same clusters; Nets inside a single cluster, and Pins without a Cell, are left out.
+   The clustered Netlist reuses the names of the original one: a cluster is named after its first Cell, a Net after its first merged Net and a Pin after one of the Pins it replaces. When both Netlists share a StringPool, clustering interns no new names.
+   The clusters are kept in a Property of the original Netlist, so the Clustering must not outlive it.
+ */
+class Clustering final
+{
+public:
+	using Index = Hypergraph::Index;
+	using Members = util::Range<std::vector<Cell>::const_iterator>;
+
+	//! Construct Clustering
+	/*!
+	   \param netlist The Netlist to cluster.
+	   \param hypergraph The Hypergraph of \p netlist.
+	   \param weights The weight of each Cell, indexed like the Cells of \p hypergraph, e.g. their areas. Empty for unit weights.
+	   \param options The scheme, the maximum cluster weight and the parallel options.
+	   \param names The StringPool of the names of the clustered Netlist, usually the one of \p netlist. If null, the clustered Netlist owns its own pool.
+	 */
+	Clustering(const Netlist & netlist, const Hypergraph & hypergraph, const std::vector<double> & weights, const ClusteringOptions & options = ClusteringOptions(), util::StringPool* names = nullptr);
+
+	//! Clustered Netlist
+	const Netlist & netlist() const
+	{
+		return mNetlist;
+	}
+
+	Netlist & netlist()
+	{
+		return mNetlist;
+	}
+
+	//! Cluster of a Cell
+	/*!
+	   \param cell A Cell of the original Netlist.
+	   \return The Cell of the clustered Netlist that contains \p cell.
+	 */
+	Cell cluster(const Cell & cell) const
+	{
+		return mClusters[cell];
+	}
+
+	//! Cells of a cluster
+	/*!
+	   \param cluster A Cell of the clustered Netlist.
+	   \return The Cells of the original Netlist in \p cluster, in the order of the original Netlist.
+	 */
+	Members members(const Cell & cluster) const
+	{
+		auto index = mIndex[cluster];
+		return Members(mMembers.begin() + mOffsets[index], mMembers.begin() + mOffsets[index + 1]);
+	}
+
+	//! Weight of a cluster
+	double weight(const Cell & cluster) const
+	{
+		return mWeights[cluster];
+	}
+
+	//! Weight of a Net
+	/*!
+	   \param net A Net of the clustered Netlist.
+	   \return The number of Nets of the original Netlist merged into \p net.
+	 */
+	std::uint32_t weight(const Net & net) const
+	{
+		return mNetWeights[net];
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the clustered Netlist, the cluster of each Cell and the members of each cluster.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
+private:
+	Netlist mNetlist;
+	entity_system::Property<Cell, Cell> mClusters;
+	entity_system::Property<Cell, Index> mIndex;
+	entity_system::Property<Cell, double> mWeights;
+	entity_system::Property<Net, std::uint32_t> mNetWeights;
+	std::vector<Index> mOffsets;
+	std::vector<Cell> mMembers;
+};
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_CLUSTERING_H
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Coarsening.h"
+#include <algorithm>
+#include <utility>
+
+namespace ophidian
+{
+namespace circuit
+{
+namespace
+{
+using Index = Hypergraph::Index;
+
+//! Best neighbor of a Cell
+/*!
+   \return The neighbor of \p cell accepted by \p accept with the best rating that fits in options.maxClusterWeight along with \p cell, or kNoIndex if there is none.
+ */
+template <class Accept>
+Index bestNeighbor(const WeightedHypergraph & fine, Index cell, const CoarseningOptions & options, double floor, std::vector<std::pair<Index, double> > & scores, Accept accept)
+{
+	scores.clear();
+	for(auto net = fine.netsBegin(cell); net != fine.netsEnd(cell); ++net)
+	{
+		const auto degree = fine.degree(*net);
+		if(degree > options.maxNetDegree)
+		{
+			continue;
+		}
+		const double score = static_cast<double>(fine.netWeights[*net]) / (degree - 1);
+		for(auto neighbor = fine.begin(*net); neighbor != fine.end(*net); ++neighbor)
+		{
+			if(*neighbor != cell && accept(*neighbor))
+			{
+				scores.emplace_back(*neighbor, score);
+			}
+		}
+	}
+	std::sort(scores.begin(), scores.end());
+	Index best = kNoIndex;
+	double bestRating = 0.0;
+	for(std::size_t score = 0; score < scores.size(); )
+	{
+		const auto neighbor = scores[score].first;
+		double rating = 0.0;
+		for(; score < scores.size() && scores[score].first == neighbor; ++score)
+		{
+			rating += scores[score].second;
+		}
+		rating /= std::max(fine.cellWeights[neighbor], floor);
+		if(rating > bestRating && fine.cellWeights[cell] + fine.cellWeights[neighbor] <= options.maxClusterWeight)
+		{
+			bestRating = rating;
+			best = neighbor;
+		}
+	}
+	return best;
+}
+} // namespace
+
+void WeightedHypergraph::transpose()
+{
+	cellOffsets.assign(cells() + 1, 0);
+	for(auto cell : netCells)
+	{
+		++cellOffsets[cell + 1];
+	}
+	std::partial_sum(cellOffsets.begin(), cellOffsets.end(), cellOffsets.begin());
+	cellNets.resize(netCells.size());
+	std::vector<Index> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+	for(Index net = 0; net < nets(); ++net)
+	{
+		for(auto cell = begin(net); cell != end(net); ++cell)
+		{
+			cellNets[cursor[*cell]++] = net;
+		}
+	}
+}
+
+WeightedHypergraph weightedHypergraph(const Hypergraph & hypergraph, const std::vector<double> & weights)
+{
+	WeightedHypergraph result;
+	if(weights.empty())
+	{
+		result.cellWeights.assign(hypergraph.size(Cell()), 1.0);
+	}
+	else
+	{
+		result.cellWeights = weights;
+	}
+	result.netCells.reserve(hypergraph.size(Pin()));
+	for(Index net = 0; net < hypergraph.size(Net()); ++net)
+	{
+		auto cells = hypergraph.cells(net);
+		result.addNet(cells.begin(), cells.end(), 1);
+	}
+	result.transpose();
+	return result;
+}
+
+void cluster(const WeightedHypergraph & fine, const CoarseningOptions & options, std::mt19937 & random, std::vector<Index> & clusters, std::vector<double> & weights)
+{
+	const auto cells = fine.cells();
+	const double floor = std::max(fine.totalWeight() / std::max<std::size_t>(cells, 1) * 1e-3, std::numeric_limits<double>::min());
+	std::vector<Index> proposals(cells, kNoIndex);
+	entity_system::parallel_for_range(cells, [&](std::size_t first, std::size_t last) {
+		std::vector<std::pair<Index, double> > scores;
+		for(auto cell = first; cell < last; ++cell)
+		{
+			proposals[cell] = bestNeighbor(fine, cell, options, floor, scores, [](Index) {
+				return true;
+			});
+		}
+	}, options.parallel);
+
+	std::vector<Index> order(cells);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), random);
+	clusters.assign(cells, kNoIndex);
+	weights.clear();
+	std::vector<std::pair<Index, double> > scores;
+	for(auto cell : order)
+	{
+		if(clusters[cell] != kNoIndex)
+		{
+			continue;
+		}
+		auto neighbor = proposals[cell];
+		if(options.matching && neighbor != kNoIndex && clusters[neighbor] != kNoIndex)
+		{
+			// the proposal was matched first: rescan for the best free neighbor
+			neighbor = bestNeighbor(fine, cell, options, floor, scores, [&clusters](Index other) {
+				return clusters[other] == kNoIndex;
+			});
+		}
+		if(neighbor != kNoIndex && clusters[neighbor] == kNoIndex)
+		{
+			clusters[cell] = clusters[neighbor] = weights.size();
+			weights.push_back(fine.cellWeights[cell] + fine.cellWeights[neighbor]);
+		}
+		else if(neighbor != kNoIndex && !options.matching && weights[clusters[neighbor]] + fine.cellWeights[cell] <= options.maxClusterWeight)
+		{
+			clusters[cell] = clusters[neighbor];
+			weights[clusters[cell]] += fine.cellWeights[cell];
+		}
+		else
+		{
+			clusters[cell] = weights.size();
+			weights.push_back(fine.cellWeights[cell]);
+		}
+	}
+}
+
+WeightedHypergraph contract(const WeightedHypergraph & fine, const std::vector<Index> & clusters, const std::vector<double> & weights, const entity_system::ParallelOptions & options, std::vector<Index> * representatives)
+{
+	// each Net is contracted in place of its fine Cells, then identical Nets are merged adding their weights
+	std::vector<Index> incidences(fine.netCells.size());
+	std::vector<Index> degrees(fine.nets());
+	std::vector<std::uint64_t> hashes(fine.nets());
+	entity_system::parallel_for_range(fine.nets(), [&](std::size_t first, std::size_t last) {
+		for(auto net = first; net < last; ++net)
+		{
+			auto begin = incidences.begin() + fine.netOffsets[net];
+			auto end = std::transform(fine.begin(net), fine.end(net), begin, [&clusters](Index cell) {
+				return clusters[cell];
+			});
+			std::sort(begin, end);
+			end = std::unique(begin, end);
+			degrees[net] = end - begin < 2 ? 0 : end - begin;
+			std::uint64_t hash = 14695981039346656037ull;
+			for(auto cell = begin; cell != end; ++cell)
+			{
+				hash = (hash ^ *cell) * 1099511628211ull;
+			}
+			hashes[net] = hash;
+		}
+	}, options);
+
+	std::vector<Index> nets;
+	for(Index net = 0; net < fine.nets(); ++net)
+	{
+		if(degrees[net] != 0)
+		{
+			nets.push_back(net);
+		}
+	}
+	std::sort(nets.begin(), nets.end(), [&hashes](Index a, Index b) {
+		return hashes[a] < hashes[b] || (hashes[a] == hashes[b] && a < b);
+	});
+	std::vector<Index> merged(fine.nets(), kNoIndex);
+	for(std::size_t group = 0; group < nets.size(); )
+	{
+		auto last = group;
+		while(last < nets.size() && hashes[nets[last]] == hashes[nets[group]])
+		{
+			++last;
+		}
+		for(auto net = group; net < last; ++net)
+		{
+			const auto a = nets[net];
+			merged[a] = a;
+			for(auto other = group; other < net; ++other)
+			{
+				const auto b = nets[other];
+				if(merged[b] == b && degrees[a] == degrees[b] &&
+				   std::equal(incidences.begin() + fine.netOffsets[a], incidences.begin() + fine.netOffsets[a] + degrees[a], incidences.begin() + fine.netOffsets[b]))
+				{
+					merged[a] = b;
+					break;
+				}
+			}
+		}
+		group = last;
+	}
+
+	WeightedHypergraph coarse;
+	coarse.cellWeights = weights;
+	std::vector<WeightedHypergraph::Weight> netWeights(fine.nets(), 0);
+	for(Index net = 0; net < fine.nets(); ++net)
+	{
+		if(merged[net] != kNoIndex)
+		{
+			netWeights[merged[net]] += fine.netWeights[net];
+		}
+	}
+	for(Index net = 0; net < fine.nets(); ++net)
+	{
+		if(merged[net] == net)
+		{
+			auto begin = incidences.begin() + fine.netOffsets[net];
+			coarse.addNet(begin, begin + degrees[net], netWeights[net]);
+		}
+	}
+	coarse.transpose();
+	if(representatives)
+	{
+		*representatives = std::move(merged);
+	}
+	return coarse;
+}
+
+} // namespace circuit
+} // namespace ophidian
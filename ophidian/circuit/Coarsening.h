@@ -0,0 +1,159 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_COARSENING_H
+#define OPHIDIAN_CIRCUIT_COARSENING_H
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <ophidian/circuit/Hypergraph.h>
+#include <ophidian/entity_system/Parallel.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Index of no Cell, cluster or Net
+const Hypergraph::Index kNoIndex = std::numeric_limits<Hypergraph::Index>::max();
+
+//! Weighted hypergraph
+/*!
+   Same compressed sparse rows as Hypergraph, with weighted Cells and Nets, for the coarsening steps shared by the partitioner and the clustering. Nets always have at least two Cells.
+ */
+struct WeightedHypergraph
+{
+	using Index = Hypergraph::Index;
+	using Weight = std::int64_t;
+
+	std::vector<Index> netOffsets{0};
+	std::vector<Index> netCells;
+	std::vector<Weight> netWeights;
+	std::vector<Index> cellOffsets;
+	std::vector<Index> cellNets;
+	std::vector<double> cellWeights;
+
+	std::size_t cells() const
+	{
+		return cellWeights.size();
+	}
+
+	std::size_t nets() const
+	{
+		return netWeights.size();
+	}
+
+	const Index * begin(Index net) const
+	{
+		return netCells.data() + netOffsets[net];
+	}
+
+	const Index * end(Index net) const
+	{
+		return netCells.data() + netOffsets[net + 1];
+	}
+
+	std::size_t degree(Index net) const
+	{
+		return netOffsets[net + 1] - netOffsets[net];
+	}
+
+	const Index * netsBegin(Index cell) const
+	{
+		return cellNets.data() + cellOffsets[cell];
+	}
+
+	const Index * netsEnd(Index cell) const
+	{
+		return cellNets.data() + cellOffsets[cell + 1];
+	}
+
+	//! Appends a Net, dropping it when it has less than two Cells
+	template <class Iterator>
+	void addNet(Iterator first, Iterator last, Weight weight)
+	{
+		if(last - first < 2)
+		{
+			return;
+		}
+		netCells.insert(netCells.end(), first, last);
+		netOffsets.push_back(netCells.size());
+		netWeights.push_back(weight);
+	}
+
+	//! Builds the Nets of each Cell from the Cells of each Net
+	void transpose();
+
+	double totalWeight() const
+	{
+		return std::accumulate(cellWeights.begin(), cellWeights.end(), 0.0);
+	}
+};
+
+//! Weighted hypergraph of a Hypergraph
+/*!
+   \param hypergraph The Hypergraph.
+   \param weights The weight of each Cell, or empty for unit weights.
+   \return The Cells of \p hypergraph with their weights, and its Nets of two Cells or more with unit weights, in order.
+ */
+WeightedHypergraph weightedHypergraph(const Hypergraph & hypergraph, const std::vector<double> & weights);
+
+//! Coarsening options
+struct CoarseningOptions
+{
+	//! No cluster may weigh more
+	double maxClusterWeight = std::numeric_limits<double>::max();
+	//! Nets with more Cells are ignored when rating neighbors
+	std::size_t maxNetDegree = 256;
+	//! Whether clusters are pairs of Cells, instead of growing around the best neighbors
+	bool matching = false;
+	//! Grain size and number of threads of the parallel steps
+	entity_system::ParallelOptions parallel;
+};
+
+//! Clusters the Cells of a weighted hypergraph
+/*!
+   Every Cell rates its neighbors, in parallel, by the weight of the Nets they share divided by the size of those Nets and by the weight of the neighbor, and proposes the best one that fits in options.maxClusterWeight. Then, in a random order, each Cell not clustered yet picks its cluster:
+   - by default, it joins the cluster of its proposal, unless that would exceed options.maxClusterWeight;
+   - with options.matching, it pairs with its proposal if that one is still free, or else with its best free neighbor.
+   A Cell that finds no cluster stays alone. Only the order depends on \p random, so the result does not depend on the number of threads.
+   \param fine The weighted hypergraph.
+   \param clusters Set to the cluster of each Cell, numbered in the order they were formed.
+   \param weights Set to the weight of each cluster.
+ */
+void cluster(const WeightedHypergraph & fine, const CoarseningOptions & options, std::mt19937 & random, std::vector<Hypergraph::Index> & clusters, std::vector<double> & weights);
+
+//! Contracts a weighted hypergraph
+/*!
+   Replaces the Cells of each Net by their clusters, in parallel, drops the Nets left inside a single cluster and merges identical Nets, adding their weights.
+   \param fine The weighted hypergraph.
+   \param clusters The cluster of each Cell of \p fine.
+   \param weights The weight of each cluster.
+   \param options The grain size and the number of threads.
+   \param representatives If not null, set to the first Net of \p fine each Net was merged into, or to kNoIndex for the dropped Nets.
+   \return The hypergraph of the clusters. Its Nets are the representatives, in order, with their Cells sorted.
+ */
+WeightedHypergraph contract(const WeightedHypergraph & fine, const std::vector<Hypergraph::Index> & clusters, const std::vector<double> & weights, const entity_system::ParallelOptions & options, std::vector<Hypergraph::Index> * representatives = nullptr);
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_COARSENING_H
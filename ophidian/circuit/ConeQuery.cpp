@@ -0,0 +1,346 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "ConeQuery.h"
+#include <algorithm>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+constexpr std::uint32_t ConeQuery::kUnbounded;
+
+ConeQuery::ConeQuery(Netlist & netlist, const DriverSinkIndex & index, bool cacheSizes) :
+	mNetlist(netlist),
+	mIndex(index),
+	mCacheSizes(cacheSizes),
+	mMarks(netlist.makeProperty<std::uint32_t>(Cell())),
+	mEpoch(0),
+	mSizes(netlist.makeSparseProperty<std::vector<CachedSize>>(Pin())),
+	mCachedLevels{{0, 0}},
+	mCellEraser(*netlist.notifier(Cell()), [this](const Cell & cell) {
+		invalidate(Net(), cell);
+	}),
+	mPinEraser(*netlist.notifier(Pin()), [this](const Pin & pin) {
+		invalidate(mNetlist.net(pin), mNetlist.cell(pin));
+	}),
+	mNetEraser(*netlist.notifier(Net()), [this](const Net & net) {
+		invalidate(net, Cell());
+	})
+{
+	if(mCacheSizes)
+	{
+		mNetlist.addListener(this);
+	}
+}
+
+ConeQuery::~ConeQuery()
+{
+	mNetlist.removeListener(this);
+}
+
+ConeQuery::Cells ConeQuery::fanout(const Pin & pin, std::uint32_t levels)
+{
+	start();
+	if(mIndex.drives(pin))
+	{
+		if(levels > 0)
+		{
+			visitSinks(mNetlist.net(pin), 1);
+		}
+	}
+	else if(mNetlist.cell(pin) != Cell())
+	{
+		visit(mNetlist.cell(pin), 0);
+	}
+	return expand(Direction::FANOUT, levels);
+}
+
+ConeQuery::Cells ConeQuery::fanout(const Cell & cell, std::uint32_t levels)
+{
+	start();
+	visit(cell, 0);
+	return expand(Direction::FANOUT, levels);
+}
+
+ConeQuery::Cells ConeQuery::fanin(const Pin & pin, std::uint32_t levels)
+{
+	start();
+	if(mIndex.drives(pin))
+	{
+		if(mNetlist.cell(pin) != Cell())
+		{
+			visit(mNetlist.cell(pin), 0);
+		}
+	}
+	else if(mNetlist.net(pin) != Net() && levels > 0)
+	{
+		visitDrivers(mNetlist.net(pin), 1);
+	}
+	return expand(Direction::FANIN, levels);
+}
+
+ConeQuery::Cells ConeQuery::fanin(const Cell & cell, std::uint32_t levels)
+{
+	start();
+	visit(cell, 0);
+	return expand(Direction::FANIN, levels);
+}
+
+std::size_t ConeQuery::fanoutSize(const Pin & pin, std::uint32_t levels)
+{
+	return size(pin, levels, Direction::FANOUT);
+}
+
+std::size_t ConeQuery::faninSize(const Pin & pin, std::uint32_t levels)
+{
+	return size(pin, levels, Direction::FANIN);
+}
+
+void ConeQuery::connected(const Net & net, const Pin & pin)
+{
+	mSizes.reset(pin);
+	invalidate(net, mNetlist.cell(pin));
+}
+
+void ConeQuery::disconnected(const Net & net, const Pin & pin)
+{
+	mSizes.reset(pin);
+	invalidate(net, mNetlist.cell(pin));
+}
+
+void ConeQuery::attached(const Cell & cell, const Pin & pin)
+{
+	mSizes.reset(pin);
+	invalidate(mNetlist.net(pin), cell);
+}
+
+util::MemoryUsage ConeQuery::memoryUsage() const
+{
+	std::size_t sizes = 0, capacity = 0;
+	for(auto const & entry : mSizes)
+	{
+		sizes += entry.second.size();
+		capacity += entry.second.capacity();
+	}
+	util::MemoryUsage usage("ConeQuery", mCone.size(), mCone.capacity());
+	usage.add("marks", mMarks.memoryUsage());
+	usage.add("cone", util::memoryUsage(mCone));
+	usage.add("levels", util::memoryUsage(mLevels));
+	usage.add("sizes", mSizes.memoryUsage());
+	usage.add("cached sizes", util::MemoryUsage("cached sizes", sizes, capacity, capacity * sizeof(CachedSize)));
+	return usage;
+}
+
+void ConeQuery::start()
+{
+	mCone.clear();
+	mLevels.clear();
+	nextEpoch();
+}
+
+void ConeQuery::nextEpoch()
+{
+	if(++mEpoch == 0)
+	{
+		// the epoch wrapped around: old marks could match again
+		std::fill(mMarks.begin(), mMarks.end(), 0);
+		mEpoch = 1;
+	}
+}
+
+void ConeQuery::visit(const Cell & cell, std::uint32_t level)
+{
+	auto & mark = mMarks[cell];
+	if(mark == mEpoch)
+	{
+		return;
+	}
+	mark = mEpoch;
+	mCone.push_back(cell);
+	mLevels.push_back(level);
+}
+
+void ConeQuery::visitSinks(const Net & net, std::uint32_t level)
+{
+	for(auto const & sink : mIndex.sinks(net))
+	{
+		auto cell = mNetlist.cell(sink);
+		if(cell != Cell())
+		{
+			visit(cell, level);
+		}
+	}
+}
+
+void ConeQuery::visitDrivers(const Net & net, std::uint32_t level)
+{
+	for(auto const & driver : mIndex.drivers(net))
+	{
+		auto cell = mNetlist.cell(driver);
+		if(cell != Cell())
+		{
+			visit(cell, level);
+		}
+	}
+}
+
+ConeQuery::Cells ConeQuery::expand(Direction direction, std::uint32_t levels)
+{
+	// the cone is the breadth-first queue: the Cells are visited in the order they were found
+	for(std::size_t next = 0; next < mCone.size(); ++next)
+	{
+		auto level = mLevels[next];
+		if(level >= levels)
+		{
+			// the levels never decrease along the queue
+			break;
+		}
+		for(auto const & pin : mNetlist.pins(mCone[next]))
+		{
+			auto net = mNetlist.net(pin);
+			if(net == Net())
+			{
+				continue;
+			}
+			auto drives = mIndex.drives(pin);
+			if(direction == Direction::FANOUT && drives)
+			{
+				visitSinks(net, level + 1);
+			}
+			else if(direction == Direction::FANIN && !drives)
+			{
+				visitDrivers(net, level + 1);
+			}
+		}
+	}
+	return Cells(mCone.begin(), mCone.end());
+}
+
+std::size_t ConeQuery::size(const Pin & pin, std::uint32_t levels, Direction direction)
+{
+	if(!mCacheSizes)
+	{
+		return static_cast<std::size_t>((direction == Direction::FANOUT ? fanout(pin, levels) : fanin(pin, levels)).size());
+	}
+	auto & cached = mSizes[pin];
+	for(auto const & entry : cached)
+	{
+		if(entry.levels == levels && entry.direction == direction)
+		{
+			return entry.size;
+		}
+	}
+	auto size = static_cast<std::size_t>((direction == Direction::FANOUT ? fanout(pin, levels) : fanin(pin, levels)).size());
+	// the query does not touch mSizes, so the reference is still valid
+	cached.push_back(CachedSize{levels, direction, size});
+	auto & cachedLevels = mCachedLevels[static_cast<std::size_t>(direction)];
+	cachedLevels = std::max(cachedLevels, levels);
+	return size;
+}
+
+void ConeQuery::invalidate(const Net & net, const Cell & cell)
+{
+	if(mSizes.size() == 0)
+	{
+		mCachedLevels = {{0, 0}};
+		return;
+	}
+	invalidate(Direction::FANOUT, net, cell);
+	invalidate(Direction::FANIN, net, cell);
+}
+
+void ConeQuery::invalidate(Direction direction, const Net & net, const Cell & cell)
+{
+	// the fan-out cones that reach the change are found upstream of it, and the fan-in cones downstream
+	nextEpoch();
+	mStale.clear();
+	if(cell != Cell())
+	{
+		reach(cell, 0);
+	}
+	if(net != Net())
+	{
+		reach(direction, net, 1);
+	}
+	const auto levels = mCachedLevels[static_cast<std::size_t>(direction)];
+	for(std::size_t next = 0; next < mStale.size(); ++next)
+	{
+		const auto cell = mStale[next].first;
+		const auto level = mStale[next].second;
+		for(auto const & pin : mNetlist.pins(cell))
+		{
+			// fan-out cones start at the Cell of a sink Pin, and fan-in cones at the Cell of a driver Pin
+			if(mIndex.drives(pin) != (direction == Direction::FANIN))
+			{
+				continue;
+			}
+			forget(pin, direction);
+			auto pinNet = mNetlist.net(pin);
+			if(pinNet != Net() && level < levels)
+			{
+				reach(direction, pinNet, level + 1);
+			}
+		}
+	}
+}
+
+void ConeQuery::reach(Direction direction, const Net & net, std::uint32_t level)
+{
+	// a Net is crossed first by the fan-out cones of its drivers and by the fan-in cones of its sinks
+	auto pins = direction == Direction::FANOUT ? mIndex.drivers(net) : mIndex.sinks(net);
+	for(auto const & pin : pins)
+	{
+		forget(pin, direction);
+		auto cell = mNetlist.cell(pin);
+		if(cell != Cell())
+		{
+			reach(cell, level);
+		}
+	}
+}
+
+void ConeQuery::reach(const Cell & cell, std::uint32_t level)
+{
+	auto & mark = mMarks[cell];
+	if(mark != mEpoch)
+	{
+		mark = mEpoch;
+		mStale.emplace_back(cell, level);
+	}
+}
+
+void ConeQuery::forget(const Pin & pin, Direction direction)
+{
+	if(!mSizes.has(pin))
+	{
+		return;
+	}
+	auto & cached = mSizes[pin];
+	cached.erase(std::remove_if(cached.begin(), cached.end(), [direction](const CachedSize & entry) {
+		return entry.direction == direction;
+	}), cached.end());
+	if(cached.empty())
+	{
+		mSizes.reset(pin);
+	}
+}
+
+} // namespace circuit
+} // namespace ophidian
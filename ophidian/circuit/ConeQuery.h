@@ -0,0 +1,181 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_CONEQUERY_H
+#define OPHIDIAN_CIRCUIT_CONEQUERY_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <ophidian/circuit/DriverSinkIndex.h>
+#include <ophidian/circuit/Netlist.h>
+#include <ophidian/entity_system/Eraser.h>
+#include <ophidian/util/MemoryUsage.h>
+#include <ophidian/util/Range.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Fan-in and fan-out cone queries
+/*!
+   Finds the Cells within a bounded number of levels upstream or downstream of a Pin or a Cell, by a breadth-first search over the Nets. One level is one Net crossed: the sinks of a driver Pin are one level downstream of it, and the drivers of a sink Pin are one level upstream of it.
+   The directions of the Pins are read from a DriverSinkIndex, so they follow the LibraryMapping and the StandardCells the index was built with. The search does not stop at sequential Cells; loops are visited once.
+   Queries are meant to be repeated, e.g. by incremental timing, ECO impact analysis or buffering: the visited Cells are marked with the epoch of the query instead of clearing a visited array, and the cone and the search frontier live in scratch buffers reused by every query. Optionally, the cone sizes of Pins are cached. Connecting or disconnecting a Pin, adding a Pin to a Cell, or erasing a Cell, a Pin or a Net only drops the cached sizes of the Pins whose cones may reach the change, found by walking from it against the direction of the cones, up to the largest number of levels cached.
+   A ConeQuery is not thread-safe; use one per thread.
+ */
+class ConeQuery final :
+	public ConnectionListener
+{
+public:
+	using Cells = util::Range<std::vector<Cell>::const_iterator>;
+	using Levels = util::Range<std::vector<std::uint32_t>::const_iterator>;
+
+	//! No bound on the number of levels
+	static constexpr std::uint32_t kUnbounded = std::numeric_limits<std::uint32_t>::max();
+
+	//! Construct ConeQuery
+	/*!
+	   \brief Attaches the visited marks to the Cells of \p netlist and, when the sizes are cached, starts listening to its changes.
+	   \param netlist The Netlist. It must outlive the query.
+	   \param index The drivers and sinks of the Nets of \p netlist. It must outlive the query.
+	   \param cacheSizes Whether fanoutSize() and faninSize() cache their results.
+	 */
+	ConeQuery(Netlist & netlist, const DriverSinkIndex & index, bool cacheSizes = false);
+
+	~ConeQuery() override;
+
+	// the query registers itself with the Netlist and its erasers capture this, so it stays where it was built
+	ConeQuery(const ConeQuery &) = delete;
+	ConeQuery & operator=(const ConeQuery &) = delete;
+	ConeQuery(ConeQuery &&) = delete;
+	ConeQuery & operator=(ConeQuery &&) = delete;
+
+	//! Fan-out cone of a Pin
+	/*!
+	   \brief Finds the Cells downstream of \p pin, in breadth-first order. A sink Pin starts at its own Cell, at level 0; a driver Pin starts at the Cells of the sinks of its Net, at level 1.
+	   \param pin The Pin.
+	   \param levels The maximum level of the Cells in the cone.
+	   \return The Cells of the cone, valid until the next query.
+	 */
+	Cells fanout(const Pin & pin, std::uint32_t levels = kUnbounded);
+
+	//! Fan-out cone of a Cell
+	/*!
+	   \brief Finds \p cell, at level 0, and the Cells downstream of its driver Pins, in breadth-first order.
+	   \return The Cells of the cone, valid until the next query.
+	 */
+	Cells fanout(const Cell & cell, std::uint32_t levels = kUnbounded);
+
+	//! Fan-in cone of a Pin
+	/*!
+	   \brief Finds the Cells upstream of \p pin, in breadth-first order. A driver Pin starts at its own Cell, at level 0; a sink Pin starts at the Cells of the drivers of its Net, at level 1.
+	   \param pin The Pin.
+	   \param levels The maximum level of the Cells in the cone.
+	   \return The Cells of the cone, valid until the next query.
+	 */
+	Cells fanin(const Pin & pin, std::uint32_t levels = kUnbounded);
+
+	//! Fan-in cone of a Cell
+	/*!
+	   \brief Finds \p cell, at level 0, and the Cells upstream of its sink Pins, in breadth-first order.
+	   \return The Cells of the cone, valid until the next query.
+	 */
+	Cells fanin(const Cell & cell, std::uint32_t levels = kUnbounded);
+
+	//! Levels of the last cone
+	/*!
+	   \return The level of each Cell of the last cone, in the same order.
+	 */
+	Levels levels() const
+	{
+		return Levels(mLevels.begin(), mLevels.end());
+	}
+
+	//! Fan-out cone size of a Pin
+	/*!
+	   \brief Counts the Cells of fanout(\p pin, \p levels). When the sizes are cached, a repeated call is a lookup until a change of the Netlist reaches the cone; otherwise, or on a miss, it runs the query and overwrites the last cone.
+	 */
+	std::size_t fanoutSize(const Pin & pin, std::uint32_t levels = kUnbounded);
+
+	//! Fan-in cone size of a Pin
+	/*!
+	   \brief Counts the Cells of fanin(\p pin, \p levels), cached like fanoutSize().
+	 */
+	std::size_t faninSize(const Pin & pin, std::uint32_t levels = kUnbounded);
+
+	//! Memory usage
+	/*!
+	   \brief Reports the visited marks, the scratch buffers and the size cache.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
+	void connected(const Net & net, const Pin & pin) override;
+	void disconnected(const Net & net, const Pin & pin) override;
+	void attached(const Cell & cell, const Pin & pin) override;
+
+private:
+	enum class Direction : std::uint32_t
+	{
+		FANIN, FANOUT
+	};
+
+	struct CachedSize
+	{
+		std::uint32_t levels;
+		Direction direction;
+		std::size_t size;
+	};
+
+	void start();
+	void nextEpoch();
+	void visit(const Cell & cell, std::uint32_t level);
+	void visitSinks(const Net & net, std::uint32_t level);
+	void visitDrivers(const Net & net, std::uint32_t level);
+	Cells expand(Direction direction, std::uint32_t levels);
+	std::size_t size(const Pin & pin, std::uint32_t levels, Direction direction);
+	void invalidate(const Net & net, const Cell & cell);
+	void invalidate(Direction direction, const Net & net, const Cell & cell);
+	void reach(Direction direction, const Net & net, std::uint32_t level);
+	void reach(const Cell & cell, std::uint32_t level);
+	void forget(const Pin & pin, Direction direction);
+
+	Netlist & mNetlist;
+	const DriverSinkIndex & mIndex;
+	bool mCacheSizes;
+	entity_system::Property<Cell, std::uint32_t> mMarks;
+	std::uint32_t mEpoch;
+	std::vector<Cell> mCone;
+	std::vector<std::uint32_t> mLevels;
+	entity_system::SparseProperty<Pin, std::vector<CachedSize>> mSizes;
+	// the largest number of levels cached in each Direction, which bounds the walks that drop stale sizes
+	std::array<std::uint32_t, 2> mCachedLevels;
+	std::vector<std::pair<Cell, std::uint32_t>> mStale;
+	// declared after the Properties: observers attached later are notified first, so the erasers still see the erased Entities
+	entity_system::Eraser<Cell> mCellEraser;
+	entity_system::Eraser<Pin> mPinEraser;
+	entity_system::Eraser<Net> mNetEraser;
+};
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_CONEQUERY_H
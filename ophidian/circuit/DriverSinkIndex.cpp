@@ -0,0 +1,159 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "DriverSinkIndex.h"
+
+namespace ophidian
+{
+namespace circuit
+{
+
+DriverSinkIndex::DriverSinkIndex(Netlist & netlist, const LibraryMapping & mapping, const standard_cell::StandardCells & stdCells, const entity_system::ParallelOptions & options) :
+	mNetlist(netlist),
+	mMapping(mapping),
+	mStdCells(stdCells),
+	mTerminals(netlist.makeProperty<Terminals>(Net())),
+	mSlots(netlist.makeProperty<Slot>(Pin())),
+	mNetEraser(*netlist.notifier(Net()), [this](const Net & net) {
+		for(auto const & pin : mTerminals[net].pins)
+		{
+			mSlots[pin] = Slot();
+		}
+		++mVersion;
+	}),
+	mPinEraser(*netlist.notifier(Pin()), [this](const Pin & pin) {
+		remove(pin);
+	}),
+	mVersion(0)
+{
+	const auto nets = netlist.begin(Net());
+	entity_system::parallel_for_range(netlist.size(Net()), [&](std::size_t first, std::size_t last) {
+		std::vector<Pin> sinks;
+		for(auto index = first; index < last; ++index)
+		{
+			const auto net = *(nets + index);
+			auto & terminals = mTerminals.begin()[index];
+			sinks.clear();
+			for(auto pin : netlist.pins(net))
+			{
+				(isDriver(pin) ? terminals.pins : sinks).push_back(pin);
+			}
+			terminals.drivers = terminals.pins.size();
+			terminals.pins.insert(terminals.pins.end(), sinks.begin(), sinks.end());
+			for(std::uint32_t position = 0; position < terminals.pins.size(); ++position)
+			{
+				auto & slot = mSlots[terminals.pins[position]];
+				slot.net = net;
+				slot.position = position;
+			}
+		}
+	}, options);
+	mNetlist.addListener(this);
+}
+
+DriverSinkIndex::~DriverSinkIndex()
+{
+	mNetlist.removeListener(this);
+}
+
+void DriverSinkIndex::connected(const Net & net, const Pin & pin)
+{
+	insert(net, pin);
+}
+
+void DriverSinkIndex::disconnected(const Net & net, const Pin & pin)
+{
+	remove(pin);
+}
+
+void DriverSinkIndex::attached(const Cell & cell, const Pin & pin)
+{
+	++mVersion;
+}
+
+util::MemoryUsage DriverSinkIndex::memoryUsage() const
+{
+	std::size_t pins = 0, capacity = 0;
+	for(auto const & terminals : mTerminals)
+	{
+		pins += terminals.pins.size();
+		capacity += terminals.pins.capacity();
+	}
+	util::MemoryUsage usage("DriverSinkIndex", pins, capacity);
+	usage.add("terminals", mTerminals.memoryUsage());
+	usage.add("pins", util::MemoryUsage("pins", pins, capacity, capacity * sizeof(Pin)));
+	usage.add("slots", mSlots.memoryUsage());
+	return usage;
+}
+
+bool DriverSinkIndex::isDriver(const Pin & pin) const
+{
+	auto stdPin = mMapping.pinStdCell(pin);
+	if(stdPin != standard_cell::Pin())
+	{
+		return mStdCells.direction(stdPin) == standard_cell::PinDirection::OUTPUT;
+	}
+	return mNetlist.input(pin) != Input();
+}
+
+void DriverSinkIndex::insert(const Net & net, const Pin & pin)
+{
+	++mVersion;
+	auto & terminals = mTerminals[net];
+	terminals.pins.push_back(pin);
+	mSlots[pin].net = net;
+	place(terminals, terminals.pins.size() - 1, pin);
+	if(isDriver(pin))
+	{
+		// the first sink moves to the end, making room for the new driver
+		place(terminals, terminals.pins.size() - 1, terminals.pins[terminals.drivers]);
+		place(terminals, terminals.drivers, pin);
+		++terminals.drivers;
+	}
+}
+
+void DriverSinkIndex::remove(const Pin & pin)
+{
+	const auto slot = mSlots[pin];
+	if(slot.net == Net())
+	{
+		return;
+	}
+	++mVersion;
+	auto & terminals = mTerminals[slot.net];
+	auto position = slot.position;
+	if(position < terminals.drivers)
+	{
+		// the last driver fills the hole, which moves to the first place of the sinks
+		--terminals.drivers;
+		place(terminals, position, terminals.pins[terminals.drivers]);
+		position = terminals.drivers;
+	}
+	place(terminals, position, terminals.pins.back());
+	terminals.pins.pop_back();
+	mSlots[pin] = Slot();
+}
+
+void DriverSinkIndex::place(Terminals & terminals, std::uint32_t position, const Pin & pin)
+{
+	terminals.pins[position] = pin;
+	mSlots[pin].position = position;
+}
+
+} // namespace circuit
+} // namespace ophidian
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_DRIVERSINKINDEX_H
+#define OPHIDIAN_CIRCUIT_DRIVERSINKINDEX_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/circuit/LibraryMapping.h>
+#include <ophidian/circuit/Netlist.h>
+#include <ophidian/entity_system/Eraser.h>
+#include <ophidian/entity_system/Parallel.h>
+#include <ophidian/standard_cell/StandardCells.h>
+#include <ophidian/util/Range.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Driver and sink index
+/*!
+   Keeps, for every Net, its driver Pins followed by its sink Pins in a vector of its own, so drivers, sinks and fanouts are read without walking the Pins of the Net or looking up their standard cells.
+   A Pin drives its Net when its standard cell Pin is an OUTPUT, or when it is a top-level Input; every other Pin, including INOUT ones, is a sink. The direction is looked up once, when the Pin is connected, so the standard cell of a Pin must be mapped before it is connected.
+   The index listens to Netlist::connect() and Netlist::disconnect() and follows the erasure of Pins and Nets, in O(1) per change. Adding a Pin to a Cell leaves the index as it is, but still changes its version().
+ */
+class DriverSinkIndex final :
+	public ConnectionListener
+{
+public:
+	using Pins = util::Range<std::vector<Pin>::const_iterator>;
+
+	//! Construct DriverSinkIndex
+	/*!
+	   \brief Indexes the current connections of \p netlist, in parallel over its Nets, and starts listening to its changes.
+	   \param netlist The Netlist. It must outlive the index.
+	   \param mapping The standard cell of each Pin.
+	   \param stdCells The standard cells, with the Pin directions.
+	   \param options The grain size and the number of threads of the initial indexing.
+	 */
+	DriverSinkIndex(Netlist & netlist, const LibraryMapping & mapping, const standard_cell::StandardCells & stdCells, const entity_system::ParallelOptions & options = entity_system::ParallelOptions());
+
+	~DriverSinkIndex() override;
+
+	// the index registers itself with the Netlist and its erasers capture this, so it stays where it was built
+	DriverSinkIndex(const DriverSinkIndex &) = delete;
+	DriverSinkIndex & operator=(const DriverSinkIndex &) = delete;
+	DriverSinkIndex(DriverSinkIndex &&) = delete;
+	DriverSinkIndex & operator=(DriverSinkIndex &&) = delete;
+
+	//! Driver of a Net
+	/*!
+	   \return The first driver of \p net, or Pin() if it has none.
+	 */
+	Pin driver(const Net & net) const
+	{
+		auto const & terminals = mTerminals[net];
+		return terminals.drivers == 0 ? Pin() : terminals.pins.front();
+	}
+
+	//! Drivers of a Net
+	/*!
+	   \return The driver Pins of \p net; more than one for multi-driven Nets.
+	 */
+	Pins drivers(const Net & net) const
+	{
+		auto const & terminals = mTerminals[net];
+		return Pins(terminals.pins.begin(), terminals.pins.begin() + terminals.drivers);
+	}
+
+	//! Sinks of a Net
+	Pins sinks(const Net & net) const
+	{
+		auto const & terminals = mTerminals[net];
+		return Pins(terminals.pins.begin() + terminals.drivers, terminals.pins.end());
+	}
+
+	//! Fanout of a Net
+	/*!
+	   \return The number of sinks of \p net, in constant time.
+	 */
+	std::size_t fanout(const Net & net) const
+	{
+		auto const & terminals = mTerminals[net];
+		return terminals.pins.size() - terminals.drivers;
+	}
+
+	//! Driver Pin
+	/*!
+	   \return true if \p pin is connected and drives its Net.
+	 */
+	bool drives(const Pin & pin) const
+	{
+		auto const & slot = mSlots[pin];
+		return slot.net != Net() && slot.position < mTerminals[slot.net].drivers;
+	}
+
+	//! Version
+	/*!
+	   \return A counter incremented on every change of the index, and whenever a Pin is added to a Cell, so results derived from the connectivity can tell whether they are stale.
+	 */
+	std::uint64_t version() const
+	{
+		return mVersion;
+	}
+
+	void connected(const Net & net, const Pin & pin) override;
+	void disconnected(const Net & net, const Pin & pin) override;
+	void attached(const Cell & cell, const Pin & pin) override;
+
+	//! Memory usage
+	/*!
+	   \brief Reports the driver and sink arrays of the Nets and the position of each Pin in them.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
+private:
+	struct Terminals
+	{
+		std::vector<Pin> pins;
+		std::uint32_t drivers = 0;
+	};
+
+	struct Slot
+	{
+		Net net;
+		std::uint32_t position = 0;
+	};
+
+	bool isDriver(const Pin & pin) const;
+	void insert(const Net & net, const Pin & pin);
+	void remove(const Pin & pin);
+	void place(Terminals & terminals, std::uint32_t position, const Pin & pin);
+
+	Netlist & mNetlist;
+	const LibraryMapping & mMapping;
+	const standard_cell::StandardCells & mStdCells;
+	entity_system::Property<Net, Terminals> mTerminals;
+	entity_system::Property<Pin, Slot> mSlots;
+	// declared after the Properties: observers attached later are notified first, so the erasers still see the data of the erased Entities
+	entity_system::Eraser<Net> mNetEraser;
+	entity_system::Eraser<Pin> mPinEraser;
+	std::uint64_t mVersion;
+};
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_DRIVERSINKINDEX_H
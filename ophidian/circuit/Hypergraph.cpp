@@ -0,0 +1,118 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Hypergraph.h"
+#include <algorithm>
+
+namespace ophidian
+{
+namespace circuit
+{
+Hypergraph::Hypergraph(const Netlist & netlist, const entity_system::ParallelOptions & options) :
+	mCells(netlist.begin(Cell()), netlist.end(Cell())),
+	mNets(netlist.begin(Net()), netlist.end(Net())),
+	mCellIndex(netlist.makeProperty<Index>(Cell())),
+	mNetIndex(netlist.makeProperty<Index>(Net())),
+	mNetOffsets(mNets.size() + 1, 0),
+	mCellOffsets(mCells.size() + 1, 0)
+{
+	entity_system::parallel_for_range(mCells.size(), [this](std::size_t first, std::size_t last) {
+		for(auto index = first; index < last; ++index)
+		{
+			mCellIndex.begin()[index] = index;
+		}
+	}, options);
+	entity_system::parallel_for_range(mNets.size(), [this](std::size_t first, std::size_t last) {
+		for(auto index = first; index < last; ++index)
+		{
+			mNetIndex.begin()[index] = index;
+		}
+	}, options);
+
+	// each Net writes its Cells in a slot as large as its number of Pins, then the slots are compacted
+	std::vector<Index> slots(mNets.size() + 1, 0);
+	for(std::size_t net = 0; net < mNets.size(); ++net)
+	{
+		slots[net + 1] = slots[net] + netlist.pins(mNets[net]).size();
+	}
+	std::vector<Index> incidences(slots.back());
+	entity_system::parallel_for_range(mNets.size(), [&](std::size_t first, std::size_t last) {
+		for(auto net = first; net < last; ++net)
+		{
+			auto begin = incidences.begin() + slots[net];
+			auto end = begin;
+			for(auto pin : netlist.pins(mNets[net]))
+			{
+				auto cell = netlist.cell(pin);
+				if(cell != Cell())
+				{
+					*end++ = index(cell);
+				}
+			}
+			std::sort(begin, end);
+			mNetOffsets[net + 1] = std::unique(begin, end) - begin;
+		}
+	}, options);
+	for(std::size_t net = 0; net < mNets.size(); ++net)
+	{
+		mNetOffsets[net + 1] += mNetOffsets[net];
+	}
+	mNetCells.resize(mNetOffsets.back());
+	entity_system::parallel_for_range(mNets.size(), [&](std::size_t first, std::size_t last) {
+		for(auto net = first; net < last; ++net)
+		{
+			std::copy_n(incidences.begin() + slots[net], mNetOffsets[net + 1] - mNetOffsets[net], mNetCells.begin() + mNetOffsets[net]);
+		}
+	}, options);
+
+	// transpose: visiting the Nets in order leaves the Nets of each Cell sorted
+	for(auto cell : mNetCells)
+	{
+		++mCellOffsets[cell + 1];
+	}
+	for(std::size_t cell = 0; cell < mCells.size(); ++cell)
+	{
+		mCellOffsets[cell + 1] += mCellOffsets[cell];
+	}
+	mCellNets.resize(mNetCells.size());
+	std::vector<Index> cursor(mCellOffsets.begin(), mCellOffsets.end() - 1);
+	for(Index net = 0; net < mNets.size(); ++net)
+	{
+		for(auto cell : cells(net))
+		{
+			mCellNets[cursor[cell]++] = net;
+		}
+	}
+}
+
+util::MemoryUsage Hypergraph::memoryUsage() const
+{
+	util::MemoryUsage usage("Hypergraph", mNetCells.size(), mNetCells.capacity());
+	usage.add("cells", util::memoryUsage(mCells));
+	usage.add("nets", util::memoryUsage(mNets));
+	usage.add("cellIndex", mCellIndex.memoryUsage());
+	usage.add("netIndex", mNetIndex.memoryUsage());
+	usage.add("netOffsets", util::memoryUsage(mNetOffsets));
+	usage.add("netCells", util::memoryUsage(mNetCells));
+	usage.add("cellOffsets", util::memoryUsage(mCellOffsets));
+	usage.add("cellNets", util::memoryUsage(mCellNets));
+	return usage;
+}
+
+} // namespace circuit
+} // namespace ophidian
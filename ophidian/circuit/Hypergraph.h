@@ -0,0 +1,169 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_HYPERGRAPH_H
+#define OPHIDIAN_CIRCUIT_HYPERGRAPH_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/circuit/Netlist.h>
+#include <ophidian/entity_system/Parallel.h>
+#include <ophidian/util/Range.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Hypergraph of a Netlist
+/*!
+   A flat, read-only snapshot of the connectivity of a Netlist, for partitioners, clusterers and analytical placers.
+   Cells and Nets get dense indices: the i-th Cell (Net) is the i-th one of the Netlist's EntitySystem, so the index of an Entity is also its position in every Property of the Netlist.
+   Both directions are stored in compressed sparse row form: the Cells of Net n are netCells()[netOffsets()[n] .. netOffsets()[n + 1]), and the Nets of Cell c are cellNets()[cellOffsets()[c] .. cellOffsets()[c + 1]), both in increasing order and without repetitions. Pins without a Cell (the top-level ports) are left out.
+   The Hypergraph does not follow later changes to the Netlist; build a new one instead.
+ */
+class Hypergraph final
+{
+public:
+	using Index = std::uint32_t;
+	using Indices = util::Range<std::vector<Index>::const_iterator>;
+
+	//! Construct Hypergraph
+	/*!
+	   \brief Builds the hypergraph of \p netlist, walking the Pins of the Nets in parallel.
+	   \param netlist The Netlist.
+	   \param options The grain size and the number of threads.
+	 */
+	explicit Hypergraph(const Netlist & netlist, const entity_system::ParallelOptions & options = entity_system::ParallelOptions());
+
+	//! Number of Cells
+	std::size_t size(Cell) const
+	{
+		return mCells.size();
+	}
+
+	//! Number of Nets
+	std::size_t size(Net) const
+	{
+		return mNets.size();
+	}
+
+	//! Number of Pins
+	/*!
+	   \return The number of (Net, Cell) incidences, i.e., the size of netCells() and cellNets().
+	 */
+	std::size_t size(Pin) const
+	{
+		return mNetCells.size();
+	}
+
+	//! Cell of an index
+	Cell cell(Index cell) const
+	{
+		return mCells[cell];
+	}
+
+	//! Net of an index
+	Net net(Index net) const
+	{
+		return mNets[net];
+	}
+
+	//! Index of a Cell
+	Index index(const Cell & cell) const
+	{
+		return mCellIndex[cell];
+	}
+
+	//! Index of a Net
+	Index index(const Net & net) const
+	{
+		return mNetIndex[net];
+	}
+
+	//! Cells of a Net
+	/*!
+	   \param net The index of the Net.
+	   \return The indices of the Cells connected to \p net.
+	 */
+	Indices cells(Index net) const
+	{
+		return Indices(mNetCells.begin() + mNetOffsets[net], mNetCells.begin() + mNetOffsets[net + 1]);
+	}
+
+	//! Nets of a Cell
+	/*!
+	   \param cell The index of the Cell.
+	   \return The indices of the Nets connected to \p cell.
+	 */
+	Indices nets(Index cell) const
+	{
+		return Indices(mCellNets.begin() + mCellOffsets[cell], mCellNets.begin() + mCellOffsets[cell + 1]);
+	}
+
+	//! Net offsets
+	/*!
+	   \return size(Net()) + 1 offsets into netCells().
+	 */
+	const std::vector<Index> & netOffsets() const
+	{
+		return mNetOffsets;
+	}
+
+	//! Cells of every Net
+	const std::vector<Index> & netCells() const
+	{
+		return mNetCells;
+	}
+
+	//! Cell offsets
+	/*!
+	   \return size(Cell()) + 1 offsets into cellNets().
+	 */
+	const std::vector<Index> & cellOffsets() const
+	{
+		return mCellOffsets;
+	}
+
+	//! Nets of every Cell
+	const std::vector<Index> & cellNets() const
+	{
+		return mCellNets;
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the Cell and Net handlers, their index Properties and both compressed sparse rows.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
+private:
+	std::vector<Cell> mCells;
+	std::vector<Net> mNets;
+	entity_system::Property<Cell, Index> mCellIndex;
+	entity_system::Property<Net, Index> mNetIndex;
+	std::vector<Index> mNetOffsets;
+	std::vector<Index> mNetCells;
+	std::vector<Index> mCellOffsets;
+	std::vector<Index> mCellNets;
+};
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_HYPERGRAPH_H
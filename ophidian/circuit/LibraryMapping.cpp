@@ -14,7 +14,7 @@ standard_cell::Cell LibraryMapping::cellStdCell(const Cell &cell) const
 
 void LibraryMapping::cellStdCell(const Cell &cell, const standard_cell::Cell &stdCell)
 {
-    cells2StdCells_[cell] = stdCell;
+    cells2StdCells_.set(cell, stdCell);
 }
 
 standard_cell::Pin LibraryMapping::pinStdCell(const Pin &pin) const
@@ -24,7 +24,33 @@ standard_cell::Pin LibraryMapping::pinStdCell(const Pin &pin) const
 
 void LibraryMapping::pinStdCell(const Pin &pin, const standard_cell::Pin &stdCell)
 {
-    pins2StdCells_[pin] = stdCell;
+    pins2StdCells_.set(pin, stdCell);
+}
+
+void LibraryMapping::checkpoint()
+{
+    cells2StdCells_.checkpoint();
+    pins2StdCells_.checkpoint();
+}
+
+void LibraryMapping::rollback()
+{
+    cells2StdCells_.rollback();
+    pins2StdCells_.rollback();
+}
+
+void LibraryMapping::commit()
+{
+    cells2StdCells_.commit();
+    pins2StdCells_.commit();
+}
+
+util::MemoryUsage LibraryMapping::memoryUsage() const
+{
+    util::MemoryUsage usage("LibraryMapping");
+    usage.add("cells2StdCells", cells2StdCells_.memoryUsage());
+    usage.add("pins2StdCells", pins2StdCells_.memoryUsage());
+    return usage;
 }
 }
 }
@@ -48,6 +48,30 @@ public:
      */
     void pinStdCell(const Pin & pin, const standard_cell::Pin & stdCell);
 
+    //! Opens a checkpoint
+    /*!
+       \brief Starts recording the changes to the mapping, so they can be reverted by rollback(). Checkpoints nest.
+     */
+    void checkpoint();
+
+    //! Reverts to the last checkpoint
+    /*!
+       \brief Restores the standard cells set since the last checkpoint, in O(changes), and closes it.
+     */
+    void rollback();
+
+    //! Commits the last checkpoint
+    /*!
+       \brief Keeps the changes made since the last checkpoint and closes it.
+     */
+    void commit();
+
+    //! Memory usage
+    /*!
+       \brief Reports the memory held by the cell and pin mappings.
+     */
+    util::MemoryUsage memoryUsage() const;
+
 private:
     ophidian::entity_system::Property<Cell, standard_cell::Cell> cells2StdCells_;
     ophidian::entity_system::Property<Pin, standard_cell::Pin> pins2StdCells_;
@@ -17,21 +17,28 @@
  */
 
 #include "Netlist.h"
+#include <algorithm>
 
 namespace ophidian
 {
 namespace circuit
 {
 
-Netlist::Netlist() :
-
+Netlist::Netlist(util::MemoryResource* resource, util::StringPool* names) :
+	mCells(resource),
+	mPins(resource),
+	mNets(resource),
+	mInputs(resource),
+	mOutputs(resource),
+	mOwnedNamePool(names ? nullptr : new util::StringPool),
+	mNamePool(names ? names : mOwnedNamePool.get()),
+	mCellNames(mCells, *mNamePool),
+	mPinNames(mPins, *mNamePool),
+	mNetNames(mNets, *mNamePool),
 	mNetPins(mNets, mPins),
 	mCellPins(mCells, mPins),
 	mPinInput(mPins, mInputs),
-	mPinOutput(mPins, mOutputs),
-	mCellNames(makeProperty<std::string>(Cell())),
-	mPinNames(makeProperty<std::string>(Pin())),
-	mNetNames(makeProperty<std::string>(Net()))
+	mPinOutput(mPins, mOutputs)
 {
 }
 
@@ -40,23 +47,25 @@ Netlist::~Netlist()
 
 }
 
-Cell Netlist::add(Cell, std::string cellName)
+Cell Netlist::add(Cell, util::StringView cellName)
 {
-    if(mName2Cell.find(cellName) == mName2Cell.end())
+	auto symbol = mCellNames.intern(cellName);
+	auto cell = mCellNames.entity(symbol);
+	if(cell == Cell())
 	{
-		auto cell = mCells.add();
-		mCellNames[cell] = cellName;
-		mName2Cell[cellName] = cell;
-		return cell;
-	}
-	else {
-		return mName2Cell[cellName];
+		cell = mCells.add();
+		mCellNames.assign(cell, symbol);
 	}
+	return cell;
+}
+
+std::vector<Cell> Netlist::add(Cell, const std::vector<std::string> &cellNames)
+{
+	return mCellNames.add(mCells, cellNames);
 }
 
 void Netlist::erase(const Cell &c)
 {
-    mName2Cell.erase(mCellNames[c]);
 	mCells.erase(c);
 }
 
@@ -65,23 +74,25 @@ uint32_t Netlist::size(Cell) const
 	return mCells.size();
 }
 
-Pin Netlist::add(Pin, std::string pinName)
+Pin Netlist::add(Pin, util::StringView pinName)
 {
-	if(mName2Pin.find(pinName) == mName2Pin.end())
+	auto symbol = mPinNames.intern(pinName);
+	auto pin = mPinNames.entity(symbol);
+	if(pin == Pin())
 	{
-		auto pin = mPins.add();
-		mPinNames[pin] = pinName;
-		mName2Pin[pinName] = pin;
-		return pin;
-	}
-	else {
-		return mName2Pin[pinName];
+		pin = mPins.add();
+		mPinNames.assign(pin, symbol);
 	}
+	return pin;
+}
+
+std::vector<Pin> Netlist::add(Pin, const std::vector<std::string> &pinNames)
+{
+	return mPinNames.add(mPins, pinNames);
 }
 
 void Netlist::erase(const Pin &en)
 {
-	mName2Pin.erase(mPinNames[en]);
 	mPins.erase(en);
 }
 
@@ -90,23 +101,25 @@ uint32_t Netlist::size(Pin) const
 	return mPins.size();
 }
 
-Net Netlist::add(Net, std::string netName)
+Net Netlist::add(Net, util::StringView netName)
 {
-	if(mName2Net.find(netName) == mName2Net.end())
+	auto symbol = mNetNames.intern(netName);
+	auto net = mNetNames.entity(symbol);
+	if(net == Net())
 	{
-		auto net = mNets.add();
-		mNetNames[net] = netName;
-		mName2Net[netName] = net;
-		return net;
-	}
-	else {
-		return mName2Net[netName];
+		net = mNets.add();
+		mNetNames.assign(net, symbol);
 	}
+	return net;
+}
+
+std::vector<Net> Netlist::add(Net, const std::vector<std::string> &netNames)
+{
+	return mNetNames.add(mNets, netNames);
 }
 
 void Netlist::erase(const Net &en)
 {
-	mName2Net.erase(mNetNames[en]);
 	mNets.erase(en);
 }
 
@@ -122,7 +135,12 @@ Net Netlist::net(const Pin &p) const
 
 void Netlist::disconnect(const Pin &p)
 {
-	mNetPins.eraseAssociation(net(p), p);
+	auto n = net(p);
+	for(auto listener : mListeners)
+	{
+		listener->disconnected(n, p);
+	}
+	mNetPins.eraseAssociation(n, p);
 }
 
 Cell Netlist::cell(const Pin &p) const
@@ -138,7 +156,7 @@ entity_system::EntitySystem<Pin>::NotifierType *Netlist::notifier(Pin) const
 void Netlist::reserve(Pin, uint32_t size)
 {
 	mPins.reserve(size);
-	mName2Pin.reserve(size);
+	mPinNames.reserve(size);
 }
 
 uint32_t Netlist::capacity(Pin) const
@@ -146,14 +164,14 @@ uint32_t Netlist::capacity(Pin) const
 	return mPins.capacity();
 }
 
-Pin Netlist::find(Pin, std::string pinName)
+Pin Netlist::find(Pin, util::StringView pinName) const
 {
-	return mName2Pin[pinName];
+	return mPinNames.find(pinName);
 }
 
 std::string Netlist::name(const Pin& pin) const
 {
-	return mPinNames[pin];
+	return mPinNames.name(pin);
 }
 
 entity_system::EntitySystem<Cell>::const_iterator Netlist::begin(Cell) const
@@ -169,6 +187,10 @@ entity_system::EntitySystem<Cell>::const_iterator Netlist::end(Cell) const
 void Netlist::add(const Cell &c, const Pin &p)
 {
 	mCellPins.addAssociation(c, p);
+	for(auto listener : mListeners)
+	{
+		listener->attached(c, p);
+	}
 }
 
 entity_system::EntitySystem<Cell>::NotifierType *Netlist::notifier(Cell) const
@@ -179,7 +201,7 @@ entity_system::EntitySystem<Cell>::NotifierType *Netlist::notifier(Cell) const
 void Netlist::reserve(Cell, uint32_t size)
 {
 	mCells.reserve(size);
-	mName2Cell.reserve(size);
+	mCellNames.reserve(size);
 }
 
 uint32_t Netlist::capacity(Cell) const
@@ -187,14 +209,14 @@ uint32_t Netlist::capacity(Cell) const
 	return mCells.capacity();
 }
 
-Cell Netlist::find(Cell, std::string cellName)
+Cell Netlist::find(Cell, util::StringView cellName) const
 {
-	return mName2Cell[cellName];
+	return mCellNames.find(cellName);
 }
 
 std::string Netlist::name(const Cell& cell) const
 {
-	return mCellNames[cell];
+	return mCellNames.name(cell);
 }
 
 entity_system::Association<Cell, Pin>::Parts Netlist::pins(const Cell &cell) const
@@ -225,6 +247,20 @@ entity_system::EntitySystem<Net>::const_iterator Netlist::end(Net) const
 void Netlist::connect(const Net &net, const Pin &pin)
 {
 	mNetPins.addAssociation(net, pin);
+	for(auto listener : mListeners)
+	{
+		listener->connected(net, pin);
+	}
+}
+
+void Netlist::addListener(ConnectionListener* listener)
+{
+	mListeners.push_back(listener);
+}
+
+void Netlist::removeListener(ConnectionListener* listener)
+{
+	mListeners.erase(std::remove(mListeners.begin(), mListeners.end(), listener), mListeners.end());
 }
 
 entity_system::EntitySystem<Net>::NotifierType *Netlist::notifier(Net) const
@@ -235,7 +271,7 @@ entity_system::EntitySystem<Net>::NotifierType *Netlist::notifier(Net) const
 void Netlist::reserve(Net, uint32_t size)
 {
 	mNets.reserve(size);
-	mName2Net.reserve(size);
+	mNetNames.reserve(size);
 }
 
 uint32_t Netlist::capacity(Net) const
@@ -243,14 +279,14 @@ uint32_t Netlist::capacity(Net) const
 	return mNets.capacity();
 }
 
-Net Netlist::find(Net, std::string netName)
+Net Netlist::find(Net, util::StringView netName) const
 {
-	return mName2Net[netName];
+	return mNetNames.find(netName);
 }
 
 std::string Netlist::name(const Net& net) const
 {
-	return mNetNames[net];
+	return mNetNames.name(net);
 }
 
 entity_system::Association<Net, Pin>::Parts Netlist::pins(const Net &net) const
@@ -336,6 +372,32 @@ entity_system::EntitySystem<Output>::NotifierType *Netlist::notifier(Output) con
 	return mOutputs.notifier();
 }
 
+void Netlist::freezeConnectivity()
+{
+	mNetPins.freeze();
+	mCellPins.freeze();
+}
+
+void Netlist::freezeNames()
+{
+	mNamePool->freeze();
+}
+
+void Netlist::permute(Cell, const std::vector<uint32_t> &order)
+{
+	mCells.permute(order);
+}
+
+void Netlist::permute(Pin, const std::vector<uint32_t> &order)
+{
+	mPins.permute(order);
+}
+
+void Netlist::permute(Net, const std::vector<uint32_t> &order)
+{
+	mNets.permute(order);
+}
+
 void Netlist::shrinkToFit()
 {
 	mCells.shrinkToFit();
@@ -345,5 +407,62 @@ void Netlist::shrinkToFit()
 	mOutputs.shrinkToFit();
 }
 
+void Netlist::save(std::ostream & out) const
+{
+	util::BinaryWriter writer(out);
+	mCells.save(writer);
+	mPins.save(writer);
+	mNets.save(writer);
+	mInputs.save(writer);
+	mOutputs.save(writer);
+	mCellNames.save(writer);
+	mPinNames.save(writer);
+	mNetNames.save(writer);
+	mNetPins.save(writer);
+	mCellPins.save(writer);
+	mPinInput.save(writer);
+	mPinOutput.save(writer);
+}
+
+void Netlist::load(std::istream & in)
+{
+	util::BinaryReader reader(in);
+	// wholes are loaded before their parts, since clearing a whole also erases its parts
+	mCells.load(reader);
+	mPins.load(reader);
+	mNets.load(reader);
+	mInputs.load(reader);
+	mOutputs.load(reader);
+	mCellNames.load(reader);
+	mPinNames.load(reader);
+	mNetNames.load(reader);
+	mNetPins.load(reader);
+	mCellPins.load(reader);
+	mPinInput.load(reader);
+	mPinOutput.load(reader);
+}
+
+util::MemoryUsage Netlist::memoryUsage() const
+{
+	util::MemoryUsage usage("Netlist");
+	usage.add("cells", mCells.memoryUsage());
+	usage.add("pins", mPins.memoryUsage());
+	usage.add("nets", mNets.memoryUsage());
+	usage.add("inputs", mInputs.memoryUsage());
+	usage.add("outputs", mOutputs.memoryUsage());
+	usage.add("cellNames", mCellNames.memoryUsage());
+	usage.add("pinNames", mPinNames.memoryUsage());
+	usage.add("netNames", mNetNames.memoryUsage());
+	usage.add("netPins", mNetPins.memoryUsage());
+	usage.add("cellPins", mCellPins.memoryUsage());
+	usage.add("pinInput", mPinInput.memoryUsage());
+	usage.add("pinOutput", mPinOutput.memoryUsage());
+	if(mOwnedNamePool)
+	{
+		usage.add("namePool", mOwnedNamePool->memoryUsage());
+	}
+	return usage;
+}
+
 } // namespace circuit
 } // namespace ophidian
@@ -22,7 +22,12 @@
 #include <ophidian/entity_system/EntitySystem.h>
 #include <ophidian/entity_system/Aggregation.h>
 #include <ophidian/entity_system/Composition.h>
-#include <unordered_map>
+#include <ophidian/entity_system/SparseProperty.h>
+#include <ophidian/entity_system/PackedProperty.h>
+#include <ophidian/entity_system/SoAProperty.h>
+#include <ophidian/entity_system/ChangeTracker.h>
+#include <ophidian/entity_system/NameIndex.h>
+#include <memory>
 
 namespace ophidian
 {
@@ -59,6 +64,28 @@ public:
 	using entity_system::EntityBase::EntityBase;
 };
 
+//! Connection Listener
+/*!
+   Receives the changes made by Netlist::connect(), Netlist::disconnect() and Netlist::add(const Cell&, const Pin&), so structures derived from the connectivity can be kept up to date incrementally.
+ */
+class ConnectionListener
+{
+public:
+	virtual ~ConnectionListener()
+	{
+
+	}
+	//! Called after \p pin is connected to \p net
+	virtual void connected(const Net& net, const Pin& pin) = 0;
+	//! Called before \p pin is disconnected from \p net
+	virtual void disconnected(const Net& net, const Pin& pin) = 0;
+	//! Called after \p pin is added to \p cell
+	virtual void attached(const Cell& cell, const Pin& pin)
+	{
+
+	}
+};
+
 /*! A flatten Netlist */
 class Netlist final
 {
@@ -70,8 +97,10 @@ public:
 	//! Construct Netlist
 	/*!
 	   \brief Constructs an empty Netlist, with no Cells, Pins or Nets.
+	   \param resource The MemoryResource for the EntitySystems and Properties of the Netlist. It must outlive the Netlist.
+	   \param names The StringPool where the names of Cells, Pins and Nets are interned, which may be shared with other structures of a design. It must outlive the Netlist. If null, the Netlist owns its own pool.
 	 */
-	Netlist();
+	explicit Netlist(util::MemoryResource* resource = util::defaultResource(), util::StringPool* names = nullptr);
 
 	//! Move Constructor
 	Netlist(Netlist&& nl) = default;
@@ -84,10 +113,17 @@ public:
 //! Add Cell
 /*!
    \param A cell name;
-   \brief Adds a Cell instance, if the cell already exist then just return the existing cell.
+   \brief Adds a Cell instance, if the cell already exist then just return the existing cell. The name is hashed and probed once either way.
    \return A handler for the created/existing Cell.
  */
-	Cell add(Cell, std::string cellName);
+	Cell add(Cell, util::StringView cellName);
+//! Add Cells
+/*!
+   \param cellNames The names of the cells.
+   \brief Adds a Cell instance for each name that doesn't exist yet, notifying the Cell's Properties only once.
+   \return The handlers for the created/existing Cells, in the same order as \p cellNames.
+ */
+	std::vector<Cell> add(Cell, const std::vector<std::string> & cellNames);
 //! Erase Cell
 /*!
    \param cell A handler for the Cell to erase.
@@ -123,6 +159,49 @@ public:
 	const {
 		return entity_system::Property<Cell, Value>(mCells);
 	}
+//! Make Cell Sparse Property
+/*!
+   \brief Creates a SparseProperty for the Cell's Entity System, for attributes that only a few Cells have.
+   \tparam Value value type of the SparseProperty.
+   \return An Cell => \p Value Map that only stores the Cells that were set.
+ */
+	template <typename Value>
+	entity_system::SparseProperty<Cell, Value> makeSparseProperty(Cell)
+	const {
+		return entity_system::SparseProperty<Cell, Value>(mCells);
+	}
+//! Make Cell Packed Property
+/*!
+   \brief Creates a PackedProperty for the Cell's Entity System, for flags and small enumerations.
+   \tparam Value value type of the PackedProperty.
+   \tparam Bits number of bits of each value.
+   \return An Cell => \p Value Map that packs 64 / \p Bits values per word.
+ */
+	template <typename Value, std::size_t Bits = 1>
+	entity_system::PackedProperty<Cell, Value, Bits> makePackedProperty(Cell)
+	const {
+		return entity_system::PackedProperty<Cell, Value, Bits>(mCells);
+	}
+//! Make Cell Structure-of-arrays Property
+/*!
+   \brief Creates a SoAProperty for the Cell's Entity System, which stores each field of \p Value in its own aligned array.
+   \tparam Value value type of the SoAProperty. entity_system::SoAFields must be specialized for it.
+   \return An Cell => \p Value Map.
+ */
+	template <typename Value>
+	entity_system::SoAProperty<Cell, Value> makeSoAProperty(Cell)
+	const {
+		return entity_system::SoAProperty<Cell, Value>(mCells);
+	}
+//! Make Cell Change Tracker
+/*!
+   \brief Creates a ChangeTracker for the Cell's Entity System, to record which Cells changed.
+   \return A ChangeTracker that drops erased Cells.
+ */
+	entity_system::ChangeTracker<Cell> makeChangeTracker(Cell)
+	const {
+		return entity_system::ChangeTracker<Cell>(mCells);
+	}
 //! Get the Cell Notifier
 /*!
    \brief Returns a pointer to the AlterationNotifier of the Cell's EntitySystem.
@@ -144,11 +223,11 @@ public:
 
 //! Find a cell
 /*!
-   \brief Using the mapping, return a cell handler by cell's name.
+   \brief Using the mapping, return a cell handler by cell's name. Does not allocate, and does not add missing names.
    \param The cell name.
-   \return Return a cell handler by cell's name.
+   \return Return a cell handler by cell's name, or Cell() if there is no such cell.
  */
-	Cell find(Cell, std::string cellName);
+	Cell find(Cell, util::StringView cellName) const;
 
 //! Returns the name of the cell
 /*!
@@ -175,10 +254,17 @@ public:
 //! Add Pin
 /*!
    \param A pin name.
-   \brief Adds a Pin instance, if the pin already exist then just return the existing pin.
+   \brief Adds a Pin instance, if the pin already exist then just return the existing pin. The name is hashed and probed once either way.
    \return A handler for the created/existing Pin.
  */
-	Pin add(Pin, std::string pinName);
+	Pin add(Pin, util::StringView pinName);
+//! Add Pins
+/*!
+   \param pinNames The names of the pins.
+   \brief Adds a Pin instance for each name that doesn't exist yet, notifying the Pin's Properties only once.
+   \return The handlers for the created/existing Pins, in the same order as \p pinNames.
+ */
+	std::vector<Pin> add(Pin, const std::vector<std::string> & pinNames);
 //! Erase Pin
 /*!
    \param pin A handler for the Pin to erase.
@@ -214,6 +300,49 @@ public:
 	const {
 		return entity_system::Property<Pin, Value>(mPins);
 	}
+//! Make Pin Sparse Property
+/*!
+   \brief Creates a SparseProperty for the Pin's Entity System, for attributes that only a few Pins have.
+   \tparam Value value type of the SparseProperty.
+   \return An Pin => \p Value Map that only stores the Pins that were set.
+ */
+	template <typename Value>
+	entity_system::SparseProperty<Pin, Value> makeSparseProperty(Pin)
+	const {
+		return entity_system::SparseProperty<Pin, Value>(mPins);
+	}
+//! Make Pin Packed Property
+/*!
+   \brief Creates a PackedProperty for the Pin's Entity System, for flags and small enumerations.
+   \tparam Value value type of the PackedProperty.
+   \tparam Bits number of bits of each value.
+   \return An Pin => \p Value Map that packs 64 / \p Bits values per word.
+ */
+	template <typename Value, std::size_t Bits = 1>
+	entity_system::PackedProperty<Pin, Value, Bits> makePackedProperty(Pin)
+	const {
+		return entity_system::PackedProperty<Pin, Value, Bits>(mPins);
+	}
+//! Make Pin Structure-of-arrays Property
+/*!
+   \brief Creates a SoAProperty for the Pin's Entity System, which stores each field of \p Value in its own aligned array.
+   \tparam Value value type of the SoAProperty. entity_system::SoAFields must be specialized for it.
+   \return An Pin => \p Value Map.
+ */
+	template <typename Value>
+	entity_system::SoAProperty<Pin, Value> makeSoAProperty(Pin)
+	const {
+		return entity_system::SoAProperty<Pin, Value>(mPins);
+	}
+//! Make Pin Change Tracker
+/*!
+   \brief Creates a ChangeTracker for the Pin's Entity System, to record which Pins changed.
+   \return A ChangeTracker that drops erased Pins.
+ */
+	entity_system::ChangeTracker<Pin> makeChangeTracker(Pin)
+	const {
+		return entity_system::ChangeTracker<Pin>(mPins);
+	}
 //! Get the Pin Notifier
 /*!
    \brief Returns a pointer to the AlterationNotifier of the Pin's EntitySystem.
@@ -234,11 +363,11 @@ public:
 
 //! Find a pin
 /*!
-   \brief Using the mapping, return a pin handler by pin's name.
+   \brief Using the mapping, return a pin handler by pin's name. Does not allocate, and does not add missing names.
    \param The pin name.
-   \return Return a pin handler by pin's name.
+   \return Return a pin handler by pin's name, or Pin() if there is no such pin.
  */
-	Pin find(Pin, std::string pinName);
+	Pin find(Pin, util::StringView pinName) const;
 
 //! Returns the name of the pin
 /*!
@@ -273,10 +402,17 @@ public:
 //! Add Net
 /*!
    \param A net name.
-   \brief Adds a Net instance, if the net already exist then just return the existing net.
+   \brief Adds a Net instance, if the net already exist then just return the existing net. The name is hashed and probed once either way.
    \return A handler for the created/existing Net.
  */
-	Net add(Net, std::string netName);
+	Net add(Net, util::StringView netName);
+//! Add Nets
+/*!
+   \param netNames The names of the nets.
+   \brief Adds a Net instance for each name that doesn't exist yet, notifying the Net's Properties only once.
+   \return The handlers for the created/existing Nets, in the same order as \p netNames.
+ */
+	std::vector<Net> add(Net, const std::vector<std::string> & netNames);
 //! Erase Net
 /*!
    \param net A handler for the Net to erase.
@@ -312,6 +448,49 @@ public:
 	const {
 		return entity_system::Property<Net, Value>(mNets);
 	}
+//! Make Net Sparse Property
+/*!
+   \brief Creates a SparseProperty for the Net's Entity System, for attributes that only a few Nets have.
+   \tparam Value value type of the SparseProperty.
+   \return An Net => \p Value Map that only stores the Nets that were set.
+ */
+	template <typename Value>
+	entity_system::SparseProperty<Net, Value> makeSparseProperty(Net)
+	const {
+		return entity_system::SparseProperty<Net, Value>(mNets);
+	}
+//! Make Net Packed Property
+/*!
+   \brief Creates a PackedProperty for the Net's Entity System, for flags and small enumerations.
+   \tparam Value value type of the PackedProperty.
+   \tparam Bits number of bits of each value.
+   \return An Net => \p Value Map that packs 64 / \p Bits values per word.
+ */
+	template <typename Value, std::size_t Bits = 1>
+	entity_system::PackedProperty<Net, Value, Bits> makePackedProperty(Net)
+	const {
+		return entity_system::PackedProperty<Net, Value, Bits>(mNets);
+	}
+//! Make Net Structure-of-arrays Property
+/*!
+   \brief Creates a SoAProperty for the Net's Entity System, which stores each field of \p Value in its own aligned array.
+   \tparam Value value type of the SoAProperty. entity_system::SoAFields must be specialized for it.
+   \return An Net => \p Value Map.
+ */
+	template <typename Value>
+	entity_system::SoAProperty<Net, Value> makeSoAProperty(Net)
+	const {
+		return entity_system::SoAProperty<Net, Value>(mNets);
+	}
+//! Make Net Change Tracker
+/*!
+   \brief Creates a ChangeTracker for the Net's Entity System, to record which Nets changed.
+   \return A ChangeTracker that drops erased Nets.
+ */
+	entity_system::ChangeTracker<Net> makeChangeTracker(Net)
+	const {
+		return entity_system::ChangeTracker<Net>(mNets);
+	}
 //! Get the Net Notifier
 /*!
    \brief Returns a pointer to the AlterationNotifier of the Net's EntitySystem.
@@ -332,11 +511,11 @@ public:
 
 //! Find a net
 /*!
-   \brief Using the mapping, return a net handler by net's name.
+   \brief Using the mapping, return a net handler by net's name. Does not allocate, and does not add missing names.
    \param The net name.
-   \return Return a net handler by net's name.
+   \return Return a net handler by net's name, or Net() if there is no such net.
  */
-	Net find(Net, std::string netName);
+	Net find(Net, util::StringView netName) const;
 
 //! Returns the name of the net
 /*!
@@ -360,6 +539,15 @@ public:
    \param pin A handler for the Pin we want to connect.
  */
 	void connect(const Net& net, const Pin& pin);
+//! Add Connection Listener
+/*!
+   \brief Reports every later connect(), disconnect() and add(const Cell&, const Pin&) to \p listener, which must be removed before it is destroyed.
+   \param listener The listener.
+   \remarks Erasing Pins or Nets, and load(), change the connections without calling the listeners.
+ */
+	void addListener(ConnectionListener* listener);
+//! Remove Connection Listener
+	void removeListener(ConnectionListener* listener);
 
 	//! Number of Inputs
 	/*!
@@ -477,11 +665,68 @@ public:
 	 */
 	entity_system::EntitySystem<Output>::NotifierType* notifier(Output) const;
 
+	//! Freeze connectivity
+	/*!
+	   \brief Builds contiguous snapshots of the Pins of every Net and of every Cell, so pins(net) and pins(cell) iterate over arrays instead of linked lists. Use it before read-only phases, such as wirelength or timing evaluation.
+	   \remarks Connecting, disconnecting or adding Pins to Cells, as well as adding or erasing Nets and Cells, invalidates the snapshots.
+	 */
+	void freezeConnectivity();
+
+	//! Freeze names
+	/*!
+	   \brief Replaces the hash table of the StringPool of the names by a perfect hash with its slots at 80% load (see util::StringPool::freeze()), which uses less memory and finds a name with a single probe. Use it once the netlist is read.
+	   \remarks Names can still be added afterwards; they go to a small overlay table until the next freeze. If the pool was given to the constructor, every structure sharing it benefits.
+	 */
+	void freezeNames();
+
+	//! Permute Cells
+	/*!
+	   \brief Reorders the Cells and all their Properties, e.g., to improve memory locality. Cell handlers stay valid.
+	   \param order A permutation of the Cell positions: the Cell at position order[i] moves to position i.
+	 */
+	void permute(Cell, const std::vector<uint32_t> & order);
+
+	//! Permute Pins
+	/*!
+	   \brief Reorders the Pins and all their Properties. Pin handlers stay valid.
+	   \param order A permutation of the Pin positions: the Pin at position order[i] moves to position i.
+	 */
+	void permute(Pin, const std::vector<uint32_t> & order);
+
+	//! Permute Nets
+	/*!
+	   \brief Reorders the Nets and all their Properties. Net handlers stay valid.
+	   \param order A permutation of the Net positions: the Net at position order[i] moves to position i.
+	 */
+	void permute(Net, const std::vector<uint32_t> & order);
+
 	//! Shrink Netlist
 	/*!
 	   \brief Shrink each EntitySystem in order to improve the memory usage.
 	 */
 	void shrinkToFit();
+
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by the Netlist: its EntitySystems, name indices, associations and its StringPool, unless the pool was given to the constructor. Properties created with makeProperty() are owned by the caller and are not included.
+	   \return A hierarchical report whose totalBytes() is the memory held by the Netlist.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
+	//! Save Netlist
+	/*!
+	   \brief Writes the Cells, Pins, Nets, Inputs and Outputs, their names and their connections as versioned, checksummed binary blocks (see util::BinaryFormat).
+	   \param out The destination stream, opened in binary mode.
+	 */
+	void save(std::ostream & out) const;
+
+	//! Load Netlist
+	/*!
+	   \brief Replaces the contents of the Netlist by the ones written by save(). Handlers saved with the Netlist stay valid, and Properties created with makeProperty() are resized with their default values, so they can be loaded next.
+	   \param in The source stream, opened in binary mode.
+	   \remarks Throws util::InvalidBinaryFormat, util::UnsupportedBinaryVersion or util::BinaryChecksumMismatch if the stream is not a saved Netlist; the contents of the Netlist are unspecified in that case.
+	 */
+	void load(std::istream & in);
 private:
 	Netlist(const Netlist& nl) = delete;
 	Netlist& operator =(const Netlist& nl) = delete;
@@ -490,16 +735,16 @@ private:
 	entity_system::EntitySystem<Net> mNets;
 	entity_system::EntitySystem<Input> mInputs;
 	entity_system::EntitySystem<Output> mOutputs;
-	entity_system::Property<Cell, std::string> mCellNames;
-	entity_system::Property<Pin, std::string> mPinNames;
-	entity_system::Property<Net, std::string> mNetNames;
-	std::unordered_map<std::string, Cell> mName2Cell;
-	std::unordered_map<std::string, Pin> mName2Pin;
-	std::unordered_map<std::string, Net> mName2Net;
+	std::unique_ptr<util::StringPool> mOwnedNamePool;
+	util::StringPool* mNamePool;
+	entity_system::NameIndex<Cell> mCellNames;
+	entity_system::NameIndex<Pin> mPinNames;
+	entity_system::NameIndex<Net> mNetNames;
 	entity_system::Aggregation<Net, Pin> mNetPins;
 	entity_system::Composition<Cell, Pin> mCellPins;
 	entity_system::Composition<Pin, Input> mPinInput;
 	entity_system::Composition<Pin, Output> mPinOutput;
+	std::vector<ConnectionListener*> mListeners;
 };
 
 } // namespace circuit
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "NetlistOrdering.h"
+#include <algorithm>
+
+namespace ophidian
+{
+namespace circuit
+{
+namespace
+{
+std::vector<uint32_t> connectivityOrder(const Netlist & netlist, std::size_t maxNetDegree, bool cuthillMcKee)
+{
+	std::vector<Cell> cells(netlist.begin(Cell()), netlist.end(Cell()));
+	auto position = netlist.makeProperty<uint32_t>(Cell());
+	for(uint32_t index = 0; index < cells.size(); ++index)
+	{
+		position[cells[index]] = index;
+	}
+
+	auto forEachNeighbour = [&](const Cell & cell, auto function) {
+		for(auto pin : netlist.pins(cell))
+		{
+			auto net = netlist.net(pin);
+			if(net == Net() || netlist.pins(net).size() > maxNetDegree)
+			{
+				continue;
+			}
+			for(auto other : netlist.pins(net))
+			{
+				auto neighbour = netlist.cell(other);
+				if(neighbour != Cell() && neighbour != cell)
+				{
+					function(position[neighbour]);
+				}
+			}
+		}
+	};
+
+	std::vector<uint32_t> degree(cells.size(), 0);
+	std::vector<uint32_t> seeds(cells.size());
+	for(uint32_t index = 0; index < cells.size(); ++index)
+	{
+		seeds[index] = index;
+		if(cuthillMcKee)
+		{
+			forEachNeighbour(cells[index], [&](uint32_t) { ++degree[index]; });
+		}
+	}
+	auto byDegree = [&degree](uint32_t a, uint32_t b) {
+		return degree[a] < degree[b];
+	};
+	if(cuthillMcKee)
+	{
+		std::stable_sort(seeds.begin(), seeds.end(), byDegree);
+	}
+
+	std::vector<uint32_t> order;
+	order.reserve(cells.size());
+	std::vector<bool> visited(cells.size(), false);
+	std::vector<uint32_t> neighbours;
+	for(auto seed : seeds)
+	{
+		if(visited[seed])
+		{
+			continue;
+		}
+		visited[seed] = true;
+		order.push_back(seed);
+		for(std::size_t head = order.size() - 1; head < order.size(); ++head)
+		{
+			neighbours.clear();
+			forEachNeighbour(cells[order[head]], [&](uint32_t neighbour) {
+				if(!visited[neighbour])
+				{
+					visited[neighbour] = true;
+					neighbours.push_back(neighbour);
+				}
+			});
+			if(cuthillMcKee)
+			{
+				std::stable_sort(neighbours.begin(), neighbours.end(), byDegree);
+			}
+			order.insert(order.end(), neighbours.begin(), neighbours.end());
+		}
+	}
+	if(cuthillMcKee)
+	{
+		std::reverse(order.begin(), order.end());
+	}
+	return order;
+}
+} // namespace
+
+std::vector<uint32_t> breadthFirstOrder(const Netlist & netlist, std::size_t maxNetDegree)
+{
+	return connectivityOrder(netlist, maxNetDegree, false);
+}
+
+std::vector<uint32_t> reverseCuthillMcKeeOrder(const Netlist & netlist, std::size_t maxNetDegree)
+{
+	return connectivityOrder(netlist, maxNetDegree, true);
+}
+
+} // namespace circuit
+} // namespace ophidian
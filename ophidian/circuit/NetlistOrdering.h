@@ -0,0 +1,52 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_NETLISTORDERING_H
+#define OPHIDIAN_CIRCUIT_NETLISTORDERING_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/circuit/Netlist.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Breadth-first Cell order
+/*!
+   \brief Orders the Cells by a breadth-first traversal of the cell graph, where two Cells are adjacent if they share a Net. Connected Cells end up close to each other in every Cell Property.
+   \param netlist The Netlist.
+   \param maxNetDegree Nets with more Pins than this (e.g., clock and reset nets) are ignored when building the cell graph.
+   \return A permutation of the Cell positions, to be given to Netlist::permute(Cell(), order).
+ */
+std::vector<uint32_t> breadthFirstOrder(const Netlist & netlist, std::size_t maxNetDegree = 64);
+
+//! Reverse Cuthill-McKee Cell order
+/*!
+   \brief Orders the Cells with the reverse Cuthill-McKee algorithm over the cell graph: a breadth-first traversal starting from low-degree Cells and visiting neighbours by increasing degree, then reversed. It reduces the bandwidth of the cell adjacency.
+   \param netlist The Netlist.
+   \param maxNetDegree Nets with more Pins than this are ignored when building the cell graph.
+   \return A permutation of the Cell positions, to be given to Netlist::permute(Cell(), order).
+ */
+std::vector<uint32_t> reverseCuthillMcKeeOrder(const Netlist & netlist, std::size_t maxNetDegree = 64);
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_NETLISTORDERING_H
@@ -0,0 +1,555 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Partitioning.h"
+#include "Coarsening.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <queue>
+#include <random>
+
+namespace ophidian
+{
+namespace circuit
+{
+namespace
+{
+using Index = Hypergraph::Index;
+using Weight = WeightedHypergraph::Weight;
+//! One level of the multilevel scheme
+using Level = WeightedHypergraph;
+
+//! Clusters the Cells of \p fine into \p coarse
+/*!
+   Each Cell joins the cluster of its best neighbor unless that would exceed \p maxClusterWeight, see circuit::cluster().
+   \return false if the clustering removed too few Cells to be worth another level.
+ */
+bool coarsen(const Level & fine, double maxClusterWeight, const PartitionOptions & options, std::mt19937 & random, Level & coarse, std::vector<Index> & clusters)
+{
+	CoarseningOptions coarsening;
+	coarsening.maxClusterWeight = maxClusterWeight;
+	coarsening.maxNetDegree = options.maxNetDegree;
+	coarsening.parallel = options.parallel;
+	std::vector<double> weights;
+	cluster(fine, coarsening, random, clusters, weights);
+	const auto cells = fine.cells();
+	if(weights.size() > cells - cells / 20)
+	{
+		return false;
+	}
+	coarse = contract(fine, clusters, weights, options.parallel);
+	return true;
+}
+
+//! Bisection of a Level
+struct Bisection
+{
+	std::vector<std::uint8_t> sides;
+	//! Cells of each Net on each side
+	std::vector<std::array<Index, 2> > counts;
+	std::array<double, 2> weights{{0.0, 0.0}};
+	std::array<double, 2> maxWeights{{0.0, 0.0}};
+	Weight cut = 0;
+
+	Bisection(const Level & level, std::vector<std::uint8_t> sides, const std::array<double, 2> & maxWeights, const entity_system::ParallelOptions & options) :
+		sides(std::move(sides)),
+		counts(level.nets()),
+		maxWeights(maxWeights)
+	{
+		entity_system::parallel_for_range(level.nets(), [&](std::size_t first, std::size_t last) {
+			for(auto net = first; net < last; ++net)
+			{
+				for(auto cell = level.begin(net); cell != level.end(net); ++cell)
+				{
+					++counts[net][this->sides[*cell]];
+				}
+			}
+		}, options);
+		for(Index cell = 0; cell < level.cells(); ++cell)
+		{
+			weights[this->sides[cell]] += level.cellWeights[cell];
+		}
+		for(Index net = 0; net < level.nets(); ++net)
+		{
+			if(counts[net][0] != 0 && counts[net][1] != 0)
+			{
+				cut += level.netWeights[net];
+			}
+		}
+	}
+
+	//! Weight above the limits of both sides
+	double overload() const
+	{
+		return std::max(weights[0] - maxWeights[0], 0.0) + std::max(weights[1] - maxWeights[1], 0.0);
+	}
+
+	//! Whether this bisection is better than (\p overload, \p cut)
+	bool better(double overload, Weight cut) const
+	{
+		const auto mine = this->overload();
+		return mine < overload || (mine == overload && this->cut < cut);
+	}
+
+	//! Reduction of the cut if \p cell changes side
+	Weight gain(const Level & level, Index cell) const
+	{
+		const auto from = sides[cell];
+		Weight gain = 0;
+		for(auto net = level.netsBegin(cell); net != level.netsEnd(cell); ++net)
+		{
+			if(counts[*net][from] == 1)
+			{
+				gain += level.netWeights[*net];
+			}
+			if(counts[*net][1 - from] == 0)
+			{
+				gain -= level.netWeights[*net];
+			}
+		}
+		return gain;
+	}
+
+	//! Whether moving \p cell keeps the balance, or improves it
+	bool feasible(const Level & level, Index cell) const
+	{
+		const auto from = sides[cell];
+		const auto to = 1 - from;
+		const auto weight = level.cellWeights[cell];
+		return weights[to] + weight <= maxWeights[to] || (weights[from] > maxWeights[from] && weights[to] + weight < weights[from]);
+	}
+
+	void move(const Level & level, Index cell)
+	{
+		cut -= gain(level, cell);
+		const auto from = sides[cell];
+		const auto to = 1 - from;
+		for(auto net = level.netsBegin(cell); net != level.netsEnd(cell); ++net)
+		{
+			--counts[*net][from];
+			++counts[*net][to];
+		}
+		weights[from] -= level.cellWeights[cell];
+		weights[to] += level.cellWeights[cell];
+		sides[cell] = to;
+	}
+
+	bool boundary(const Level & level, Index cell) const
+	{
+		for(auto net = level.netsBegin(cell); net != level.netsEnd(cell); ++net)
+		{
+			if(counts[*net][0] != 0 && counts[*net][1] != 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+//! Label propagation
+/*!
+   The gains of the boundary Cells are computed in parallel, then the Cells with positive gains are moved, best first, if their gain is still positive and the balance allows it.
+ */
+void propagate(const Level & level, Bisection & bisection, std::size_t rounds, const entity_system::ParallelOptions & options)
+{
+	std::vector<Weight> gains(level.cells());
+	std::vector<Index> candidates;
+	for(std::size_t round = 0; round < rounds; ++round)
+	{
+		entity_system::parallel_for_range(level.cells(), [&](std::size_t first, std::size_t last) {
+			for(auto cell = first; cell < last; ++cell)
+			{
+				gains[cell] = bisection.boundary(level, cell) ? bisection.gain(level, cell) : 0;
+			}
+		}, options);
+		candidates.clear();
+		for(Index cell = 0; cell < level.cells(); ++cell)
+		{
+			if(gains[cell] > 0)
+			{
+				candidates.push_back(cell);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [&gains](Index a, Index b) {
+			return gains[a] > gains[b] || (gains[a] == gains[b] && a < b);
+		});
+		std::size_t moves = 0;
+		for(auto cell : candidates)
+		{
+			if(bisection.feasible(level, cell) && bisection.gain(level, cell) > 0)
+			{
+				bisection.move(level, cell);
+				++moves;
+			}
+		}
+		if(moves == 0)
+		{
+			break;
+		}
+	}
+}
+
+//! Fiduccia-Mattheyses pass
+/*!
+   Moves the boundary Cells, each one at most once, always taking the best gain whose move keeps the balance, and then undoes the moves made after the best bisection seen.
+   \return true if the pass improved the bisection.
+ */
+bool fiducciaMattheyses(const Level & level, Bisection & bisection, const entity_system::ParallelOptions & options)
+{
+	using Entry = std::pair<Weight, Index>;
+	std::vector<Weight> gains(level.cells());
+	std::vector<bool> locked(level.cells(), false);
+	entity_system::parallel_for_range(level.cells(), [&](std::size_t first, std::size_t last) {
+		for(auto cell = first; cell < last; ++cell)
+		{
+			gains[cell] = bisection.gain(level, cell);
+		}
+	}, options);
+	std::priority_queue<Entry> queue;
+	for(Index cell = 0; cell < level.cells(); ++cell)
+	{
+		if(bisection.boundary(level, cell))
+		{
+			queue.emplace(gains[cell], cell);
+		}
+	}
+	auto update = [&](Index cell, Weight delta) {
+		if(!locked[cell])
+		{
+			gains[cell] += delta;
+			queue.emplace(gains[cell], cell);
+		}
+	};
+	auto updateNet = [&](Index net, Weight delta) {
+		for(auto cell = level.begin(net); cell != level.end(net); ++cell)
+		{
+			update(*cell, delta);
+		}
+	};
+	// the only other Cell of the side, if it is free; the moving Cell is already locked
+	auto updateSide = [&](Index net, std::uint8_t side, Weight delta) {
+		for(auto cell = level.begin(net); cell != level.end(net); ++cell)
+		{
+			if(!locked[*cell] && bisection.sides[*cell] == side)
+			{
+				update(*cell, delta);
+				return;
+			}
+		}
+	};
+
+	std::vector<Index> moves;
+	auto bestOverload = bisection.overload();
+	auto bestCut = bisection.cut;
+	std::size_t bestMoves = 0;
+	const std::size_t patience = std::max<std::size_t>(64, level.cells() / 64);
+	while(!queue.empty() && moves.size() - bestMoves <= patience)
+	{
+		const auto entry = queue.top();
+		queue.pop();
+		const auto cell = entry.second;
+		if(locked[cell] || entry.first != gains[cell] || !bisection.feasible(level, cell))
+		{
+			continue;
+		}
+		locked[cell] = true;
+		const auto from = bisection.sides[cell];
+		const auto to = 1 - from;
+		for(auto net = level.netsBegin(cell); net != level.netsEnd(cell); ++net)
+		{
+			const auto weight = level.netWeights[*net];
+			auto & counts = bisection.counts[*net];
+			if(counts[to] == 0)
+			{
+				updateNet(*net, weight);
+			}
+			else if(counts[to] == 1)
+			{
+				updateSide(*net, to, -weight);
+			}
+			--counts[from];
+			++counts[to];
+			if(counts[from] == 0)
+			{
+				updateNet(*net, -weight);
+			}
+			else if(counts[from] == 1)
+			{
+				updateSide(*net, from, weight);
+			}
+		}
+		bisection.cut -= entry.first;
+		bisection.weights[from] -= level.cellWeights[cell];
+		bisection.weights[to] += level.cellWeights[cell];
+		bisection.sides[cell] = to;
+		moves.push_back(cell);
+		if(bisection.better(bestOverload, bestCut))
+		{
+			bestOverload = bisection.overload();
+			bestCut = bisection.cut;
+			bestMoves = moves.size();
+		}
+	}
+	for(auto move = moves.size(); move > bestMoves; --move)
+	{
+		bisection.move(level, moves[move - 1]);
+	}
+	return bestMoves != 0;
+}
+
+void refine(const Level & level, Bisection & bisection, const PartitionOptions & options, const entity_system::ParallelOptions & parallel)
+{
+	propagate(level, bisection, 4, parallel);
+	for(std::size_t pass = 0; pass < options.passes; ++pass)
+	{
+		if(!fiducciaMattheyses(level, bisection, parallel))
+		{
+			break;
+		}
+	}
+}
+
+//! Initial bisection of the coarsest Level
+/*!
+   Grows side 0 from random Cells, in breadth-first order, up to \p target, and refines it. The tries run in parallel and the best one, or the first among equals, is kept.
+ */
+Bisection initialBisection(const Level & level, double target, const std::array<double, 2> & maxWeights, const PartitionOptions & options, std::uint32_t seed)
+{
+	const std::int64_t tries = std::max<std::size_t>(options.initialTries, 1);
+	const entity_system::ParallelOptions serial(options.parallel.grainSize, 1);
+	std::vector<Bisection> bisections;
+	bisections.reserve(tries);
+	for(std::int64_t attempt = 0; attempt < tries; ++attempt)
+	{
+		bisections.emplace_back(level, std::vector<std::uint8_t>(level.cells(), 1), maxWeights, serial);
+	}
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1) num_threads(entity_system::parallelThreads(options.parallel)) if(tries > 1)
+#endif
+	for(std::int64_t attempt = 0; attempt < tries; ++attempt)
+	{
+		std::mt19937 random(seed + attempt);
+		std::vector<Index> order(level.cells());
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), random);
+		std::vector<std::uint8_t> sides(level.cells(), 1);
+		std::vector<bool> visited(level.cells(), false);
+		std::deque<Index> queue;
+		double weight = 0.0;
+		for(auto seedCell = order.begin(); weight < target && seedCell != order.end(); ++seedCell)
+		{
+			if(visited[*seedCell])
+			{
+				continue;
+			}
+			visited[*seedCell] = true;
+			queue.push_back(*seedCell);
+			while(weight < target && !queue.empty())
+			{
+				const auto cell = queue.front();
+				queue.pop_front();
+				if(weight + level.cellWeights[cell] > maxWeights[0])
+				{
+					continue;
+				}
+				sides[cell] = 0;
+				weight += level.cellWeights[cell];
+				for(auto net = level.netsBegin(cell); net != level.netsEnd(cell); ++net)
+				{
+					for(auto neighbor = level.begin(*net); neighbor != level.end(*net); ++neighbor)
+					{
+						if(!visited[*neighbor])
+						{
+							visited[*neighbor] = true;
+							queue.push_back(*neighbor);
+						}
+					}
+				}
+			}
+			queue.clear();
+		}
+		bisections[attempt] = Bisection(level, std::move(sides), maxWeights, serial);
+		refine(level, bisections[attempt], options, serial);
+	}
+	std::size_t best = 0;
+	for(std::size_t attempt = 1; attempt < bisections.size(); ++attempt)
+	{
+		if(bisections[attempt].better(bisections[best].overload(), bisections[best].cut))
+		{
+			best = attempt;
+		}
+	}
+	return std::move(bisections[best]);
+}
+
+//! Multilevel bisection
+/*!
+   \param fraction The share of the total weight that goes to side 0.
+   \return The side of each Cell of \p level.
+ */
+std::vector<std::uint8_t> bisect(const Level & level, double fraction, double imbalance, const PartitionOptions & options, std::uint32_t seed)
+{
+	const double total = level.totalWeight();
+	const double target = total * fraction;
+	const std::array<double, 2> maxWeights{{target * (1.0 + imbalance), (total - target) * (1.0 + imbalance)}};
+	const double maxClusterWeight = total / std::max<std::size_t>(options.coarsestSize, 2);
+	std::mt19937 random(seed);
+
+	// levels[0] is the finest coarse level; clusters[l] maps the Cells of the level above to the Cells of levels[l]
+	std::deque<Level> levels;
+	std::deque<std::vector<Index> > clusters;
+	const Level * current = &level;
+	while(current->cells() > options.coarsestSize)
+	{
+		levels.emplace_back();
+		clusters.emplace_back();
+		if(!coarsen(*current, maxClusterWeight, options, random, levels.back(), clusters.back()))
+		{
+			levels.pop_back();
+			clusters.pop_back();
+			break;
+		}
+		current = &levels.back();
+	}
+
+	auto bisection = initialBisection(*current, target, maxWeights, options, seed);
+	for(auto coarse = levels.size(); coarse > 0; --coarse)
+	{
+		const auto & fine = coarse == 1 ? level : levels[coarse - 2];
+		const auto & map = clusters[coarse - 1];
+		std::vector<std::uint8_t> sides(fine.cells());
+		for(Index cell = 0; cell < fine.cells(); ++cell)
+		{
+			sides[cell] = bisection.sides[map[cell]];
+		}
+		levels.pop_back();
+		bisection = Bisection(fine, std::move(sides), maxWeights, options.parallel);
+		refine(fine, bisection, options, options.parallel);
+	}
+	return std::move(bisection.sides);
+}
+
+//! Recursive bisection
+/*!
+   Splits \p level into \p parts parts numbered from \p firstPart, writing the part of \p cells[i] for each Cell i of \p level. Nets cut by a bisection are kept on both sides, restricted to their Cells there, so the recursion also minimizes the number of parts each Net spans.
+ */
+void partition(const Level & level, const std::vector<Index> & cells, std::uint32_t firstPart, std::uint32_t parts, double imbalance, const PartitionOptions & options, std::uint32_t seed, std::vector<std::uint32_t> & result)
+{
+	if(parts == 1 || level.cells() < 2)
+	{
+		for(auto cell : cells)
+		{
+			result[cell] = firstPart;
+		}
+		return;
+	}
+	const std::uint32_t left = parts / 2;
+	const auto sides = bisect(level, static_cast<double>(left) / parts, imbalance, options, seed);
+
+	std::vector<Index> indices(level.cells());
+	for(std::uint8_t side = 0; side < 2; ++side)
+	{
+		Level sub;
+		std::vector<Index> subCells;
+		for(Index cell = 0; cell < level.cells(); ++cell)
+		{
+			if(sides[cell] == side)
+			{
+				indices[cell] = sub.cellWeights.size();
+				sub.cellWeights.push_back(level.cellWeights[cell]);
+				subCells.push_back(cells[cell]);
+			}
+		}
+		std::vector<Index> netCells;
+		for(Index net = 0; net < level.nets(); ++net)
+		{
+			netCells.clear();
+			for(auto cell = level.begin(net); cell != level.end(net); ++cell)
+			{
+				if(sides[*cell] == side)
+				{
+					netCells.push_back(indices[*cell]);
+				}
+			}
+			sub.addNet(netCells.begin(), netCells.end(), level.netWeights[net]);
+		}
+		sub.transpose();
+		partition(sub, subCells, side == 0 ? firstPart : firstPart + left, side == 0 ? left : parts - left, imbalance, options, seed * 2 + side + 1, result);
+	}
+}
+} // namespace
+
+Partition partition(const Hypergraph & hypergraph, const std::vector<double> & weights, const PartitionOptions & options)
+{
+	assert(options.parts > 0);
+	assert(weights.empty() || weights.size() == hypergraph.size(Cell()));
+	auto level = weightedHypergraph(hypergraph, weights);
+
+	// the allowed imbalance is shared among the levels of the recursion
+	const auto depth = std::ceil(std::log2(static_cast<double>(options.parts)));
+	const auto imbalance = depth > 0 ? std::pow(1.0 + options.imbalance, 1.0 / depth) - 1.0 : options.imbalance;
+
+	std::vector<Index> cells(level.cells());
+	std::iota(cells.begin(), cells.end(), 0);
+	Partition result;
+	result.parts.assign(level.cells(), 0);
+	partition(level, cells, 0, options.parts, imbalance, options, options.seed, result.parts);
+	evaluate(hypergraph, weights, result, options.parts, options.parallel);
+	return result;
+}
+
+void evaluate(const Hypergraph & hypergraph, const std::vector<double> & weights, Partition & partition, std::uint32_t parts, const entity_system::ParallelOptions & options)
+{
+	partition.weights.assign(parts, 0.0);
+	for(Index cell = 0; cell < partition.parts.size(); ++cell)
+	{
+		partition.weights[partition.parts[cell]] += weights.empty() ? 1.0 : weights[cell];
+	}
+	std::vector<Index> spans(hypergraph.size(Net()));
+	entity_system::parallel_for_range(spans.size(), [&](std::size_t first, std::size_t last) {
+		std::vector<std::uint32_t> netParts;
+		for(auto net = first; net < last; ++net)
+		{
+			netParts.clear();
+			for(auto cell : hypergraph.cells(net))
+			{
+				netParts.push_back(partition.parts[cell]);
+			}
+			std::sort(netParts.begin(), netParts.end());
+			spans[net] = std::unique(netParts.begin(), netParts.end()) - netParts.begin();
+		}
+	}, options);
+	partition.cut = 0;
+	partition.connectivity = 0;
+	for(auto span : spans)
+	{
+		if(span > 1)
+		{
+			++partition.cut;
+			partition.connectivity += span - 1;
+		}
+	}
+}
+
+} // namespace circuit
+} // namespace ophidian
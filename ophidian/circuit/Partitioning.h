@@ -0,0 +1,102 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_CIRCUIT_PARTITIONING_H
+#define OPHIDIAN_CIRCUIT_PARTITIONING_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/circuit/Hypergraph.h>
+#include <ophidian/entity_system/Parallel.h>
+
+namespace ophidian
+{
+namespace circuit
+{
+
+//! Partitioning options
+struct PartitionOptions
+{
+	//! Construct PartitionOptions
+	/*!
+	   \param parts The number of parts.
+	   \param imbalance The allowed imbalance: no part may weigh more than (1 + imbalance) times its share of the total weight.
+	 */
+	PartitionOptions(std::uint32_t parts = 2, double imbalance = 0.03) :
+		parts(parts),
+		imbalance(imbalance)
+	{
+
+	}
+
+	std::uint32_t parts;
+	double imbalance;
+	//! Coarsening stops when a level has at most this many Cells
+	std::size_t coarsestSize = 160;
+	//! Nets with more Cells are ignored when rating Cells for coarsening
+	std::size_t maxNetDegree = 256;
+	//! Number of initial bisections tried on the coarsest level
+	std::size_t initialTries = 8;
+	//! Maximum number of Fiduccia-Mattheyses passes on each level
+	std::size_t passes = 8;
+	//! Seed of the random visiting orders
+	std::uint32_t seed = 0;
+	//! Grain size and number of threads of the parallel steps
+	entity_system::ParallelOptions parallel;
+};
+
+//! Partition of a Hypergraph
+struct Partition
+{
+	//! Part of each Cell, indexed like the Cells of the Hypergraph
+	std::vector<std::uint32_t> parts;
+	//! Total weight of each part
+	std::vector<double> weights;
+	//! Number of Nets with Cells in more than one part
+	std::size_t cut = 0;
+	//! Sum over the Nets of the number of parts they span minus one
+	std::size_t connectivity = 0;
+};
+
+//! Multilevel partitioning
+/*!
+   \brief Splits the Cells of \p hypergraph into options.parts balanced parts, minimizing the Nets between parts.
+   k-way partitions are built by recursive bisection. Each bisection coarsens the hypergraph by clustering strongly connected Cells, bisects the coarsest level, and then projects the bisection back level by level, refining it with Fiduccia-Mattheyses passes.
+   Ratings and contractions during coarsening, the initial bisections and the gains of the boundary Cells during refinement are computed in parallel; the result only depends on options.seed, not on the number of threads.
+   \param hypergraph The Hypergraph of the Netlist.
+   \param weights The weight of each Cell, indexed like the Cells of \p hypergraph, e.g. their areas. Empty for unit weights.
+   \param options The number of parts, the allowed imbalance and the tuning parameters.
+   \return The part of each Cell, the part weights and the cost of the partition.
+ */
+Partition partition(const Hypergraph & hypergraph, const std::vector<double> & weights, const PartitionOptions & options = PartitionOptions());
+
+//! Evaluate a partition
+/*!
+   \brief Fills the weights, cut and connectivity of \p partition from its parts.
+   \param hypergraph The Hypergraph of the Netlist.
+   \param weights The weight of each Cell, or empty for unit weights.
+   \param partition A partition whose parts are set, with part numbers smaller than \p parts.
+   \param parts The number of parts.
+   \param options The grain size and the number of threads of the count of the parts of each Net.
+ */
+void evaluate(const Hypergraph & hypergraph, const std::vector<double> & weights, Partition & partition, std::uint32_t parts, const entity_system::ParallelOptions & options = entity_system::ParallelOptions());
+
+} // namespace circuit
+} // namespace ophidian
+
+#endif // OPHIDIAN_CIRCUIT_PARTITIONING_H
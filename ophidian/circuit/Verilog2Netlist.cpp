@@ -36,28 +36,48 @@ void verilog2Netlist(const parser::Verilog &verilog, Netlist &netlist){
 	netlist.reserve(Cell(), module.instances().size());
 
 
-	for(auto net : module.nets())
-		netlist.add(Net(), net.name());
+	std::vector<std::string> netNames;
+	netNames.reserve(module.nets().size());
+	for(auto & net : module.nets())
+		netNames.push_back(net.name());
+	netlist.add(Net(), netNames);
 
-	for(auto port : module.ports())
+	std::vector<std::string> pinNames;
+	pinNames.reserve(sizePins);
+	for(auto & port : module.ports())
+		pinNames.push_back(port.name());
+	for(auto & instance : module.instances())
+		for(auto & portMap : instance.portMapping())
+			pinNames.push_back(instance.name()+":"+portMap.first->name());
+	auto pins = netlist.add(Pin(), pinNames);
+
+	std::vector<std::string> cellNames;
+	cellNames.reserve(module.instances().size());
+	for(auto & instance : module.instances())
+		cellNames.push_back(instance.name());
+	auto cells = netlist.add(Cell(), cellNames);
+
+	auto pin = pins.begin();
+	for(auto & port : module.ports())
 	{
-		auto pin = netlist.add(Pin(), port.name());
 		if(port.direction() == parser::Verilog::PortDirection::INPUT)
-			netlist.add(Input(), pin);
+			netlist.add(Input(), *pin);
 		else if(port.direction() == parser::Verilog::PortDirection::OUTPUT)
-			netlist.add(Output(), pin);
-		netlist.connect(netlist.find(Net(), port.name()), pin);
+			netlist.add(Output(), *pin);
+		netlist.connect(netlist.find(Net(), port.name()), *pin);
+		++pin;
 	}
 
-	for(auto instance : module.instances())
+	auto cell = cells.begin();
+	for(auto & instance : module.instances())
 	{
-		auto cell = netlist.add(Cell(), instance.name());
-		for(auto portMap : instance.portMapping())
+		for(auto & portMap : instance.portMapping())
 		{
-			auto pin = netlist.add(Pin(), instance.name()+":"+portMap.first->name());
-			netlist.add(cell, pin);
-			netlist.connect(netlist.find(Net(), portMap.second->name()), pin);
+			netlist.add(*cell, *pin);
+			netlist.connect(netlist.find(Net(), portMap.second->name()), *pin);
+			++pin;
 		}
+		++cell;
 	}
 }
 } // namespace circuit
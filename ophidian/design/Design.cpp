@@ -24,12 +24,15 @@ namespace ophidian
 namespace design
 {
 
-Design::Design() :
-
-	mNetlist(),
-	mFloorplan(),
+Design::Design(Memory memory) :
+	mArena(util::defaultResource(), util::HugePageResource::kHugePageSize),
+	mResource(memory == Memory::Arena ? static_cast<util::MemoryResource*>(&mArena) :
+	          memory == Memory::HugePages ? static_cast<util::MemoryResource*>(&mHugePages) :
+	          util::defaultResource()),
+	mNetlist(mResource, &mNames),
+	mFloorplan(mResource, &mNames),
 	mPlacement(mNetlist),
-	mStandardCells(),
+	mStandardCells(mResource, &mNames),
 	mLibrary(mStandardCells),
 	mLibraryMapping(mNetlist)
 {
@@ -41,6 +44,28 @@ Design::~Design()
 
 }
 
+void Design::freezeNames()
+{
+	mNames.freeze();
+}
+
+util::MemoryUsage Design::memoryUsage() const
+{
+	util::MemoryUsage usage("Design");
+	usage.add("netlist", mNetlist.memoryUsage());
+	usage.add("floorplan", mFloorplan.memoryUsage());
+	usage.add("placement", mPlacement.memoryUsage());
+	usage.add("standardCells", mStandardCells.memoryUsage());
+	usage.add("library", mLibrary.memoryUsage());
+	usage.add("libraryMapping", mLibraryMapping.memoryUsage());
+	usage.add("names", mNames.memoryUsage());
+	if(mResource == &mArena)
+	{
+		usage.add("arena", util::MemoryUsage("", mArena.allocatedBytes(), mArena.reservedBytes(), mArena.reservedBytes() - mArena.allocatedBytes()));
+	}
+	return usage;
+}
+
 } //namespace design
 
 } //namespace ophidian
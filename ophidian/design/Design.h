@@ -25,6 +25,8 @@
 #include <ophidian/placement/Library.h>
 #include <ophidian/circuit/LibraryMapping.h>
 #include <ophidian/standard_cell/StandardCells.h>
+#include <ophidian/util/MemoryResource.h>
+#include <ophidian/util/StringPool.h>
 
 namespace ophidian
 {
@@ -36,12 +38,20 @@ namespace design
 class Design
 {
 public:
+	//! Backing memory of a Design
+	enum class Memory
+	{
+		Heap,     //!< Storage comes from the heap and is given back as soon as a container releases it.
+		Arena,    //!< Storage comes from a monotonic arena owned by the design: allocation and teardown are cheap, but nothing is given back before the design is destroyed.
+		HugePages //!< Blocks of 2 MiB or more are backed by transparent huge pages (Linux only); smaller blocks come from the heap.
+	};
 
 	//! Design Constructor
 	/*!
-	   \brief Constructs a design system with no properties
+	   \brief Constructs a design system with no properties. Every EntitySystem and Property of the design allocates from the resource chosen by \p memory.
+	   \param memory Where the storage of the design comes from. Memory::Arena suits designs that are read once and not edited, since buffers outgrown by containers, erased Entities and derived Properties stay in the arena until the design is destroyed.
 	 */
-	Design();
+	explicit Design(Memory memory = Memory::Heap);
 
 	//! Design Destructor
 	/*!
@@ -109,9 +119,46 @@ public:
 		return mLibraryMapping;
 	}
 
+	//! memory resource getter
+	/*!
+	   \brief Get the resource the design allocates from, to allocate additional EntitySystems that live as long as the design.
+	   \return The design's MemoryResource.
+	 */
+	util::MemoryResource * resource()
+	{
+		return mResource;
+	}
+
+	//! names getter
+	/*!
+	   \brief Get the pool where the names of cells, pins, nets, sites and standard cells of the design are interned, so each distinct name is stored once.
+	   \return The design's StringPool.
+	 */
+	const util::StringPool & names() const
+	{
+		return mNames;
+	}
+
+	//! Freeze names
+	/*!
+	   \brief Replaces the hash table of the design's StringPool by a perfect hash with its slots at 80% load (see util::StringPool::freeze()), making name lookups in the netlist, floorplan and standard cells faster and smaller. The design builders call it once the files are read; names added later still work.
+	 */
+	void freezeNames();
+
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by every component of the design.
+	   \return A hierarchical report with one child per component. With Memory::Arena, a last "arena" child counts the arena's reserved but unused bytes; its size and capacity are the allocated and reserved bytes, which include the buffers the containers outgrew.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
 
 private:
 
+	util::HugePageResource mHugePages;
+	util::MonotonicArena mArena;
+	util::MemoryResource * mResource;
+	util::StringPool mNames;
 	circuit::Netlist mNetlist;
 	floorplan::Floorplan mFloorplan;
 	placement::Placement mPlacement;
@@ -56,6 +56,7 @@ Design & ICCAD2017ContestDesignBuilder::build()
 	floorplan::lefDef2Floorplan(*mLef, *mDef, mDesign.floorplan());
 	placement::lef2Library(*mLef, mDesign.library(), mDesign.standardCells());
 	circuit::def2LibraryMapping(*mDef, mDesign.netlist(), mDesign.standardCells(), mDesign.libraryMapping());
+	mDesign.freezeNames();
 
     return mDesign;
 }
@@ -97,6 +98,7 @@ Design & ICCAD2015ContestDesignBuilder::build()
 	floorplan::lefDef2Floorplan(*mLef, *mDef, mDesign.floorplan());
 	placement::def2placement(*mDef, mDesign.placement(), mDesign.netlist());
 	circuit::verilog2Netlist(*mVerilog, mDesign.netlist());
+	mDesign.freezeNames();
 
     return mDesign;
 }
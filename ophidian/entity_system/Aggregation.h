@@ -59,12 +59,23 @@ public:
 		Parent::erase(whole);
 	}
 
-	void clear() override
+	void erase(const std::vector<Whole>& wholes) override
 	{
-		for(auto const & part : Parent::mPartSystem)
+		for(auto const & whole : wholes)
 		{
-			Parent::eraseAssociation(Parent::whole(part), part);
+			Part current = Parent::firstPart(whole);
+			while(current != Part())
+			{
+				Part next = Parent::nextPart(current);
+				Parent::eraseAssociation(whole, current);
+				current = next;
+			}
 		}
+	}
+
+	void clear() override
+	{
+		Parent::unlinkAllParts();
 		Parent::clear();
 	}
 private:
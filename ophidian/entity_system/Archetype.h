@@ -0,0 +1,373 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_ARCHETYPE_H
+#define OPHIDIAN_ENTITY_SYSTEM_ARCHETYPE_H
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <ophidian/util/MemoryUsage.h>
+#include "EntitySystem.h"
+#include "Property.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Archetype
+/*!
+   An EntitySystem bundled with a set of components known at compile time, given as the type list \p Components_.
+   Each component is stored in its own contiguous array, indexed like the Entities, and accessed by its position in the type list with get<I>().
+   The whole bundle is kept in sync by a single observer whose lifecycle operations are unrolled at compile time, so adding, erasing or permuting Entities costs one virtual call for all components instead of one per Property.
+   Properties and Associations created from system() are still attached dynamically, e.g., for user extensions.
+ */
+template <class Entity_, class ... Components_>
+class Archetype
+{
+	static_assert(sizeof...(Components_) > 0, "Archetype: at least one component is required");
+public:
+	using Entity = Entity_;
+	using SystemType = EntitySystem<Entity>;
+	using const_iterator = typename SystemType::const_iterator;
+	using size_type = typename SystemType::size_type;
+	using Components = std::tuple<Components_...>;
+	template <std::size_t I>
+	using Component = typename std::tuple_element<I, Components>::type;
+	template <class Value>
+	using Storage = std::vector<Value, util::PolymorphicAllocator<Value> >;
+	template <std::size_t I>
+	using ContainerType = Storage<Component<I> >;
+	static constexpr std::size_t kComponents = sizeof...(Components_);
+
+	//! Construct Archetype
+	/*!
+	   \brief Constructs an empty Archetype.
+	   \param resource The MemoryResource for the Entities, the components and the attached Properties.
+	 */
+	explicit Archetype(util::MemoryResource* resource = util::defaultResource()) :
+		mSystem(resource),
+		mBundle(mSystem)
+	{
+
+	}
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	//! Add Entity
+	/*!
+	   \return A handler for the created Entity. Its components are value-initialized.
+	 */
+	Entity add()
+	{
+		return mSystem.add();
+	}
+
+	//! Add Entity with components
+	/*!
+	   \brief Creates an Entity and sets all its components, in the order of the type list.
+	   \return A handler for the created Entity.
+	 */
+	Entity emplace(const Components_& ... components)
+	{
+		auto entity = mSystem.add();
+		set(entity, Components(components...), std::index_sequence_for<Components_...>());
+		return entity;
+	}
+
+	//! Add Entities
+	/*!
+	   \return A range with the handlers of the \p n created Entities. See EntitySystem::add(size_type).
+	 */
+	util::Range<const_iterator> add(size_type n)
+	{
+		return mSystem.add(n);
+	}
+
+	//! Erase Entity
+	void erase(const Entity& entity)
+	{
+		mSystem.erase(entity);
+	}
+
+	//! Erase Entities
+	/*!
+	   \brief Erases many Entities at once. See EntitySystem::erase(const EntityRange&).
+	 */
+	template <class EntityRange>
+	void erase(const EntityRange& entities)
+	{
+		mSystem.erase(entities);
+	}
+
+	//! Clear Entities
+	void clear()
+	{
+		mSystem.clear();
+	}
+
+	//! Permute Entities
+	/*!
+	   \brief Reorders the Entities and their components. See EntitySystem::permute().
+	 */
+	void permute(const std::vector<uint32_t>& order)
+	{
+		mSystem.permute(order);
+	}
+
+	//! Component of an Entity
+	/*!
+	   \tparam I The position of the component in the type list.
+	   \param entity A handler for the Entity.
+	 */
+	template <std::size_t I>
+	Component<I>& get(const Entity& entity)
+	{
+		return std::get<I>(mBundle.mContainers)[mSystem.id(entity)];
+	}
+	template <std::size_t I>
+	const Component<I>& get(const Entity& entity) const
+	{
+		return std::get<I>(mBundle.mContainers)[mSystem.id(entity)];
+	}
+
+	//! Component array
+	/*!
+	   \brief Returns the contiguous array of a component, indexed like the Entities.
+	   \remarks The pointer is invalidated when Entities are added or erased.
+	 */
+	template <std::size_t I>
+	Component<I>* data()
+	{
+		return std::get<I>(mBundle.mContainers).data();
+	}
+	template <std::size_t I>
+	const Component<I>* data() const
+	{
+		return std::get<I>(mBundle.mContainers).data();
+	}
+
+	//! Entity System
+	/*!
+	   \brief Returns the underlying EntitySystem, to attach Properties and Associations at runtime.
+	 */
+	const SystemType& system() const
+	{
+		return mSystem;
+	}
+
+	//! Make Property
+	/*!
+	   \brief Creates a Property attached at runtime, for attributes outside the type list.
+	   \tparam Value value type of the Property.
+	 */
+	template <class Value>
+	Property<Entity, Value> makeProperty() const
+	{
+		return Property<Entity, Value>(mSystem);
+	}
+
+	bool valid(const Entity& entity) const
+	{
+		return mSystem.valid(entity);
+	}
+	size_type size() const
+	{
+		return mSystem.size();
+	}
+	size_type capacity() const
+	{
+		return mSystem.capacity();
+	}
+	bool empty() const
+	{
+		return mSystem.empty();
+	}
+	void reserve(uint32_t size)
+	{
+		mSystem.reserve(size);
+	}
+	void shrinkToFit()
+	{
+		mSystem.shrinkToFit();
+	}
+	const_iterator begin() const
+	{
+		return mSystem.begin();
+	}
+	const_iterator end() const
+	{
+		return mSystem.end();
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the EntitySystem and one child per component.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		util::MemoryUsage usage("Archetype");
+		usage.add("system", mSystem.memoryUsage());
+		std::size_t component = 0;
+		mBundle.forEach([&usage, &component](const auto & container) {
+			usage.add("component" + std::to_string(component++), util::memoryUsage(container));
+		});
+		return usage;
+	}
+
+private:
+	//! The components, kept in sync with the EntitySystem by a single observer
+	class Bundle :
+		public SystemType::NotifierType::ObserverBase
+	{
+public:
+		using Parent = typename SystemType::NotifierType::ObserverBase;
+
+		Bundle(const SystemType& system) :
+			Parent(*system.notifier()),
+			mSystem(system),
+			mContainers(Storage<Components_>(util::PolymorphicAllocator<Components_>(system.resource()))...)
+		{
+
+		}
+
+		template <class Function>
+		void forEach(Function f)
+		{
+			forEach(f, std::index_sequence_for<Components_...>());
+		}
+		template <class Function>
+		void forEach(Function f) const
+		{
+			forEach(f, std::index_sequence_for<Components_...>());
+		}
+
+		void reserve(uint32_t size) override
+		{
+			forEach([size](auto & container) {
+				container.reserve(size);
+			});
+		}
+		void shrinkToFit() override
+		{
+			forEach([](auto & container) {
+				container.shrink_to_fit();
+			});
+		}
+
+		const SystemType& mSystem;
+		std::tuple<Storage<Components_>...> mContainers;
+
+protected:
+		void add(const Entity& item) override
+		{
+			forEach([](auto & container) {
+				container.emplace_back();
+			});
+		}
+		void add(const std::vector<Entity>& items) override
+		{
+			forEach([&items](auto & container) {
+				container.resize(container.size() + items.size());
+			});
+		}
+		void erase(const Entity& item) override
+		{
+			auto index = mSystem.id(item);
+			forEach([index](auto & container) {
+				std::swap(container[index], container.back());
+				container.pop_back();
+			});
+		}
+		void erase(const std::vector<Entity>& items) override
+		{
+			// the components are dropped in compact(), once every observer was notified
+		}
+		void compact(const std::vector<bool>& erased) override
+		{
+			forEach([&erased](auto & container) {
+				std::size_t last = 0;
+				for(std::size_t index = 0; index < container.size(); ++index)
+				{
+					if(!erased[index])
+					{
+						if(index != last)
+						{
+							container[last] = std::move(container[index]);
+						}
+						++last;
+					}
+				}
+				container.erase(container.begin() + last, container.end());
+			});
+		}
+		void permute(const std::vector<uint32_t>& order) override
+		{
+			forEach([&order](auto & container) {
+				typename std::decay<decltype(container)>::type permuted(container.get_allocator());
+				permuted.reserve(container.capacity());
+				for(auto index : order)
+				{
+					permuted.push_back(std::move(container[index]));
+				}
+				container.swap(permuted);
+			});
+		}
+		void clear() override
+		{
+			forEach([](auto & container) {
+				container.clear();
+			});
+		}
+
+private:
+		template <class Function, std::size_t ... I>
+		void forEach(Function & f, std::index_sequence<I...>)
+		{
+			using expand = int[];
+			(void)expand{0, (f(std::get<I>(mContainers)), 0)...};
+		}
+		template <class Function, std::size_t ... I>
+		void forEach(Function & f, std::index_sequence<I...>) const
+		{
+			using expand = int[];
+			(void)expand{0, (f(std::get<I>(mContainers)), 0)...};
+		}
+	};
+
+	template <std::size_t ... I>
+	void set(const Entity& entity, Components&& components, std::index_sequence<I...>)
+	{
+		auto index = mSystem.id(entity);
+		using expand = int[];
+		(void)expand{0, (std::get<I>(mBundle.mContainers)[index] = std::move(std::get<I>(components)), 0)...};
+	}
+
+	SystemType mSystem;
+	Bundle mBundle;
+};
+
+template <class Entity_, class ... Components_>
+constexpr std::size_t Archetype<Entity_, Components_...>::kComponents;
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_ARCHETYPE_H
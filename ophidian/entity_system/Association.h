@@ -20,6 +20,7 @@
 #define OPHIDIAN_ENTITY_SYSTEM_ASSOCIATION_H
 
 #include "Property.h"
+#include <algorithm>
 #include <cassert>
 
 namespace ophidian
@@ -33,8 +34,7 @@ class DetachedProperty :  public Property<Key, Value >
 public:
 	using Parent = Property<Key, Value >;
 	DetachedProperty(const EntitySystem<Key>& system) :
-		Parent(system),
-		mSystem(system)
+		Parent(system)
 	{
 		Parent::detach();
 	}
@@ -42,22 +42,9 @@ public:
 	using Parent::add;
 	using Parent::build;
 	using Parent::clear;
-
-	virtual void erase(const Key& item) override
-	{
-		std::swap(Parent::mProperties.back(), Parent::mProperties[mSystem.id(item)]);
-		Parent::mProperties.pop_back();
-	}
-
-	const Value& operator [](const Key & k) const {
-		return Parent::mProperties[mSystem.id(k)];
-	}
-
-	Value& operator [](const Key & k) {
-		return Parent::mProperties[mSystem.id(k)];
-	}
-private:
-	const EntitySystem<Key>& mSystem;
+	using Parent::compact;
+	using Parent::erase;
+	using Parent::permute;
 };
 
 //! Association
@@ -82,6 +69,7 @@ public:
 		PartOfComposition(const EntitySystem<Part>& partSystem, Association& composition) :
 			EntitySystem<Part>::NotifierType::ObserverBase(*partSystem.notifier()),
 			mNextPart(partSystem),
+			mPrevPart(partSystem),
 			mWhole(partSystem),
 			mAssociation(composition)
 		{
@@ -107,30 +95,74 @@ public:
 			mNextPart[p1] = p2;
 		}
 
+		Part prevPart(const Part &p) const
+		{
+			return mPrevPart[p];
+		}
+
+		void prevPart(const Part& p1, const Part& p2)
+		{
+			mPrevPart[p1] = p2;
+		}
+
+		void unlinkAll()
+		{
+			std::fill(mNextPart.begin(), mNextPart.end(), Part());
+			std::fill(mPrevPart.begin(), mPrevPart.end(), Part());
+			std::fill(mWhole.begin(), mWhole.end(), Whole());
+		}
+
+		void save(util::BinaryWriter& writer) const
+		{
+			mNextPart.save(writer, NEXT_PARTS);
+			mPrevPart.save(writer, PREVIOUS_PARTS);
+			mWhole.save(writer, WHOLES);
+		}
+
+		void load(util::BinaryReader& reader)
+		{
+			mNextPart.load(reader, NEXT_PARTS);
+			mPrevPart.load(reader, PREVIOUS_PARTS);
+			mWhole.load(reader, WHOLES);
+		}
+
+		util::MemoryUsage memoryUsage() const
+		{
+			util::MemoryUsage usage("PartOfComposition");
+			usage.add("nextPart", mNextPart.memoryUsage());
+			usage.add("prevPart", mPrevPart.memoryUsage());
+			usage.add("whole", mWhole.memoryUsage());
+			return usage;
+		}
+
 
 private:
 
 		void shrinkToFit() override
 		{
 			mNextPart.shrinkToFit();
+			mPrevPart.shrinkToFit();
 			mWhole.shrinkToFit();
 		}
 
 		void reserve(std::uint32_t size) override
 		{
 			mNextPart.reserve(size);
+			mPrevPart.reserve(size);
 			mWhole.reserve(size);
 		}
 
 		void add(const Part & item ) override
 		{
 			mNextPart.add(item);
+			mPrevPart.add(item);
 			mWhole.add(item);
 		}
 
 		void add(const std::vector<Part> & items) override
 		{
 			mNextPart.add(items);
+			mPrevPart.add(items);
 			mWhole.add(items);
 		}
 
@@ -141,18 +173,46 @@ private:
 				mAssociation.eraseAssociation(whole(item), item);
 			}
 			mNextPart.erase(item);
+			mPrevPart.erase(item);
 			mWhole.erase(item);
 		}
 
+		void erase(const std::vector<Part>& items) override
+		{
+			for(auto const & item : items)
+			{
+				if(whole(item) != Whole())
+				{
+					mAssociation.eraseAssociation(whole(item), item);
+				}
+			}
+		}
+
+		void compact(const std::vector<bool>& erased) override
+		{
+			mNextPart.compact(erased);
+			mPrevPart.compact(erased);
+			mWhole.compact(erased);
+		}
+
+		void permute(const std::vector<uint32_t>& order) override
+		{
+			mNextPart.permute(order);
+			mPrevPart.permute(order);
+			mWhole.permute(order);
+		}
+
 		void clear() override
 		{
 			mAssociation.detachAllParts();
 			mNextPart.clear();
+			mPrevPart.clear();
 			mWhole.clear();
 		}
 
 		Association& mAssociation;
 		DetachedProperty<Part, Part> mNextPart;
+		DetachedProperty<Part, Part> mPrevPart;
 		DetachedProperty<Part, Whole> mWhole;
 	};
 
@@ -161,6 +221,7 @@ public:
 	//! Parts
 	/*!
 	   A wrapper class to provide a iterable interface (begin(), end()) for the Parts container of a Whole.
+	   When the Association is frozen, iterates over the contiguous snapshot instead of following the linked list.
 	 */
 	class Parts
 	{
@@ -171,36 +232,45 @@ public:
 public:
 			PartIterator(const Association * association, const Whole& w) :
 				mAssociation(association),
-				mWhole(w),
-				mPart(association->firstPart(w))
+				mPart(association->firstPart(w)),
+				mSnapshotPart(nullptr)
+			{
+
+			}
+
+			PartIterator(const Part * snapshotPart) :
+				mAssociation(nullptr),
+				mPart(Part()),
+				mSnapshotPart(snapshotPart)
 			{
 
 			}
 
 			PartIterator() :
 				mAssociation(nullptr),
-				mWhole(Whole()),
-				mPart(Part())
+				mPart(Part()),
+				mSnapshotPart(nullptr)
 			{
 
 			}
 
 			const Part& operator*() {
-				return mPart;
+				return mSnapshotPart ? *mSnapshotPart : mPart;
 			}
 			PartIterator & operator++(void) {
-				mPart = mAssociation->nextPart(mPart);
-				return *this;
-			}
-			PartIterator & operator=(const PartIterator & p)
-			{
-				mAssociation = p.mAssociation;
-				mWhole = p.mWhole;
+				if(mSnapshotPart)
+				{
+					++mSnapshotPart;
+				}
+				else
+				{
+					mPart = mAssociation->nextPart(mPart);
+				}
 				return *this;
 			}
 			bool operator!=(const PartIterator & p) const
 			{
-				return mPart != p.mPart;
+				return mSnapshotPart != p.mSnapshotPart || mPart != p.mPart;
 			}
 			bool operator==(const PartIterator & p) const
 			{
@@ -208,8 +278,8 @@ public:
 			}
 private:
 			const Association * mAssociation;
-			Whole mWhole;
 			Part mPart;
+			const Part * mSnapshotPart;
 		};
 
 		Parts(const Association & association, const Whole & whole) :
@@ -221,10 +291,18 @@ private:
 
 		PartIterator begin() const
 		{
+			if(mAssociation.frozen())
+			{
+				return PartIterator(mAssociation.mSnapshotParts.data() + mAssociation.mSnapshotOffsets[mAssociation.mWholeSystem.id(mWhole)]);
+			}
 			return PartIterator(&mAssociation, mWhole);
 		}
 		PartIterator end() const
 		{
+			if(mAssociation.frozen())
+			{
+				return PartIterator(mAssociation.mSnapshotParts.data() + mAssociation.mSnapshotOffsets[mAssociation.mWholeSystem.id(mWhole) + 1]);
+			}
 			return PartIterator();
 		}
 		uint32_t size() const
@@ -249,7 +327,9 @@ private:
 		mFirstPart(whole),
 		mPart2Whole(part, *this),
 		mPartSystem(part),
-		mNumParts(whole, 0)
+		mNumParts(whole, 0),
+		mWholeSystem(whole),
+		mFrozen(false)
 	{
 		EntitySystem<Whole>::NotifierType::ObserverBase::detach();
 	}
@@ -273,55 +353,94 @@ private:
 	 */
 	void addAssociation(const Whole& w, const Part& p)
 	{
+		mFrozen = false;
 		auto first = firstPart(w);
 
-		mPart2Whole.whole(p, w);
-
-		if(first == Whole())
+		whole(p, w);
+		prevPart(p, Part());
+		nextPart(p, first);
+		if(first != Part())
 		{
-			mFirstPart[w] = p;
-			mNumParts[w] = 1;
-			return;
+			prevPart(first, p);
 		}
-
-		mFirstPart[w] = p;
-		mPart2Whole.nextPart(p, first);
+		firstPart(w, p);
 		++mNumParts[w];
-
 	}
 
 	//! Erase association
 	/*!
-	   \brief Remove the association between Part and Whole entities.
+	   \brief Remove the association between Part and Whole entities, in constant time.
 	   \param w A handler for the Whole Entity.
 	   \param p A handler for the Part Entity.
 	 */
 	void eraseAssociation(const Whole& w, const Part& p)
 	{
+		assert(whole(p) == w);
+		mFrozen = false;
 		--mNumParts[w];
 
-		whole(p, Whole());
-
-
-		if(p == firstPart(w))
+		Part prev = prevPart(p);
+		Part next = nextPart(p);
+		if(prev != Part())
 		{
-			firstPart(w, nextPart(p));
-			return;
+			nextPart(prev, next);
 		}
-
-		Part prev = firstPart(w);
-		Part curr = nextPart(firstPart(w));
-		while(curr != p && curr != Part())
+		else
 		{
-			prev = curr;
-			curr = nextPart(curr);
+			firstPart(w, next);
 		}
+		if(next != Part())
+		{
+			prevPart(next, prev);
+		}
+
+		whole(p, Whole());
+		prevPart(p, Part());
+		nextPart(p, Part());
+	}
 
-		if(curr == p)
+	//! Freeze the Association
+	/*!
+	   \brief Builds a compressed sparse row snapshot of the Association: the parts of each whole are stored contiguously, in the same order as the linked list, and parts() iterates over them.
+	   \remarks Any change to the Association or to the Whole EntitySystem invalidates the snapshot, and parts() falls back to the linked list until freeze() is called again.
+	 */
+	void freeze()
+	{
+		mSnapshotOffsets.resize(mWholeSystem.size() + 1);
+		mSnapshotParts.resize(mPartSystem.size());
+		uint32_t offset = 0;
+		uint32_t index = 0;
+		for(auto const & w : mWholeSystem)
 		{
-			nextPart(prev, nextPart(curr));
+			mSnapshotOffsets[index++] = offset;
+			for(Part p = firstPart(w); p != Part(); p = nextPart(p))
+			{
+				mSnapshotParts[offset++] = p;
+			}
 		}
+		mSnapshotOffsets[index] = offset;
+		mSnapshotParts.resize(offset);
+		mFrozen = true;
+	}
 
+	//! Release the snapshot
+	/*!
+	   \brief Invalidates the snapshot built by freeze() and releases its memory.
+	 */
+	void thaw()
+	{
+		mFrozen = false;
+		std::vector<uint32_t>().swap(mSnapshotOffsets);
+		std::vector<Part>().swap(mSnapshotParts);
+	}
+
+	//! Frozen Association
+	/*!
+	   \return true if parts() iterates over a valid snapshot, false otherwise.
+	 */
+	bool frozen() const
+	{
+		return mFrozen;
 	}
 
 	//! Get the parts of a whole
@@ -359,7 +478,7 @@ private:
 	   \brief Returns the next part of a whole, given the current part.
 	   \param p A handler for the current part of a Whole
 	   \return A handler for the next Part in association, after \p w.
-	   \remarks The association is implemented as a linked list. A Whole entity has a property containing the handler for its first part. Each part has a property containing the next part in association. We assume a part can only be part of one whole at a time.
+	   \remarks The association is implemented as a doubly linked list. A Whole entity has a property containing the handler for its first part. Each part has properties containing the previous and the next parts in association. We assume a part can only be part of one whole at a time.
 	 */
 	Part nextPart(const Part& p) const {
 		return mPart2Whole.nextPart(p);
@@ -375,10 +494,57 @@ private:
 		return mNumParts[w];
 	}
 
+	//! Save Association
+	/*!
+	   \brief Writes the links between Wholes and Parts, which are stored as Entity handlers and stay valid once both EntitySystems are loaded.
+	   \param writer The destination of the binary blocks.
+	 */
+	void save(util::BinaryWriter& writer) const {
+		mFirstPart.save(writer, FIRST_PARTS);
+		mNumParts.save(writer, NUMBER_OF_PARTS);
+		mPart2Whole.save(writer);
+	}
+
+	//! Load Association
+	/*!
+	   \brief Reads the links written by save(), after both the Whole and the Part EntitySystems were loaded. The Association is thawed.
+	   \param reader The source of the binary blocks.
+	 */
+	void load(util::BinaryReader& reader) {
+		thaw();
+		mFirstPart.load(reader, FIRST_PARTS);
+		mNumParts.load(reader, NUMBER_OF_PARTS);
+		mPart2Whole.load(reader);
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the per-Whole and per-Part link Properties and, when frozen, the CSR snapshot.
+	 */
+	util::MemoryUsage memoryUsage() const {
+		util::MemoryUsage usage("Association");
+		usage.add("firstPart", mFirstPart.memoryUsage());
+		usage.add("numParts", mNumParts.memoryUsage());
+		usage.add("parts", mPart2Whole.memoryUsage());
+		if(mSnapshotOffsets.capacity() != 0 || mSnapshotParts.capacity() != 0)
+		{
+			usage.add("snapshotOffsets", util::memoryUsage(mSnapshotOffsets));
+			usage.add("snapshotParts", util::memoryUsage(mSnapshotParts));
+		}
+		return usage;
+	}
+
 protected:
 
+	void unlinkAllParts()
+	{
+		mPart2Whole.unlinkAll();
+		detachAllParts();
+	}
+
 	void detachAllParts()
 	{
+		mFrozen = false;
 		std::fill(mNumParts.begin(), mNumParts.end(), 0);
 		std::fill(mFirstPart.begin(), mFirstPart.end(), Part());
 	}
@@ -395,21 +561,43 @@ protected:
 
 	virtual void add(const Whole & item ) override
 	{
+		mFrozen = false;
 		mFirstPart.add(item);
 	}
 
 	virtual void add(const std::vector<Whole> & items) override
 	{
+		mFrozen = false;
 		mFirstPart.add(items);
 	}
 
 	virtual void erase(const Whole& item) override
 	{
+		mFrozen = false;
 		mFirstPart.erase(item);
 	}
 
+	virtual void erase(const std::vector<Whole>& items) override
+	{
+		// the first parts are dropped in compact(), once every observer was notified
+		mFrozen = false;
+	}
+
+	virtual void compact(const std::vector<bool>& erased) override
+	{
+		mFrozen = false;
+		mFirstPart.compact(erased);
+	}
+
+	virtual void permute(const std::vector<uint32_t>& order) override
+	{
+		mFrozen = false;
+		mFirstPart.permute(order);
+	}
+
 	virtual void clear() override
 	{
+		mFrozen = false;
 		mFirstPart.clear();
 	}
 
@@ -417,6 +605,10 @@ protected:
 	DetachedProperty<Whole, Part> mFirstPart;
 	Property<Whole, uint32_t> mNumParts;
 	PartSystem& mPartSystem;
+	const WholeSystem& mWholeSystem;
+	bool mFrozen;
+	std::vector<uint32_t> mSnapshotOffsets;
+	std::vector<Part> mSnapshotParts;
 
 private:
 	void whole(const Part& p, const Whole& w)
@@ -432,6 +624,14 @@ private:
 		mPart2Whole.nextPart(p1, p2);
 	}
 
+	Part prevPart(const Part& p) const {
+		return mPart2Whole.prevPart(p);
+	}
+
+	void prevPart(const Part& p1, const Part &p2) {
+		mPart2Whole.prevPart(p1, p2);
+	}
+
 
 };
 
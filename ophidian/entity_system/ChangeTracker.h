@@ -0,0 +1,193 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_CHANGETRACKER_H
+#define OPHIDIAN_ENTITY_SYSTEM_CHANGETRACKER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Property.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Change Tracker
+/*!
+   Records which Entities changed, so incremental algorithms only revisit those. Several consumers can subscribe, and each one drains the changes made since its own last drain.
+   Changes are kept in a log stamped with increasing positions. Each Entity remembers the position of its last entry, so an Entity changed many times between drains is reported once, and the log only holds entries some consumer has not seen yet.
+   Attach it to a Property with Property::trackChanges() to record every write through Property::set(), or call touch() directly.
+ */
+template <class Entity_>
+class ChangeTracker :
+	public ChangeListener<Entity_>
+{
+public:
+	using Entity = Entity_;
+	using Consumer = std::size_t;
+
+	//! Construct ChangeTracker
+	/*!
+	   \param system The EntitySystem of the tracked Entities. Erased Entities are dropped from the pending changes.
+	 */
+	ChangeTracker(const EntitySystem<Entity>& system) :
+		mSystem(system),
+		mLastChange(system, kNever),
+		mBase(0)
+	{
+
+	}
+
+	//! Subscribe a consumer
+	/*!
+	   \return A consumer that will see the changes made from now on.
+	 */
+	Consumer subscribe()
+	{
+		auto cursor = end();
+		for(Consumer consumer = 0; consumer < mCursors.size(); ++consumer)
+		{
+			if(mCursors[consumer] == kNever)
+			{
+				mCursors[consumer] = cursor;
+				return consumer;
+			}
+		}
+		mCursors.push_back(cursor);
+		return mCursors.size() - 1;
+	}
+
+	//! Unsubscribe a consumer
+	void unsubscribe(Consumer consumer)
+	{
+		mCursors[consumer] = kNever;
+		truncate();
+	}
+
+	//! Mark an Entity as changed
+	/*!
+	   \brief Records a change of \p entity. Does nothing when there are no consumers, or when every consumer is yet to see a previous change of \p entity.
+	 */
+	void touch(const Entity& entity) override
+	{
+		auto maxCursor = maximumCursor();
+		if(maxCursor == kNever)
+		{
+			return;
+		}
+		auto & last = mLastChange[entity];
+		if(last != kNever && last >= maxCursor)
+		{
+			return;
+		}
+		last = end();
+		mLog.push_back(entity);
+	}
+
+	//! Drain the changes of a consumer
+	/*!
+	   \brief Returns the Entities changed since the last drain of \p consumer, each one once, and advances the consumer.
+	   \param consumer A subscribed consumer.
+	   \return The changed Entities that are still alive, in the order of their last change.
+	 */
+	std::vector<Entity> drain(Consumer consumer)
+	{
+		std::vector<Entity> changed;
+		for(auto position = mCursors[consumer]; position < end(); ++position)
+		{
+			auto const & entity = mLog[position - mBase];
+			if(mSystem.valid(entity) && mLastChange[entity] == position)
+			{
+				changed.push_back(entity);
+			}
+		}
+		mCursors[consumer] = end();
+		truncate();
+		return changed;
+	}
+
+	//! Pending changes
+	/*!
+	   \return true if \p consumer has changes to drain.
+	 */
+	bool pending(Consumer consumer) const
+	{
+		return mCursors[consumer] < end();
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the last change of each Entity, the change log and the consumer cursors.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		util::MemoryUsage usage("ChangeTracker", mLog.size(), mLog.capacity(), mLog.capacity() * sizeof(Entity) + mCursors.capacity() * sizeof(std::uint64_t));
+		usage.add("lastChange", mLastChange.memoryUsage());
+		return usage;
+	}
+
+private:
+	static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+
+	std::uint64_t end() const
+	{
+		return mBase + mLog.size();
+	}
+
+	std::uint64_t maximumCursor() const
+	{
+		std::uint64_t cursor = kNever;
+		for(auto consumer : mCursors)
+		{
+			if(consumer != kNever)
+			{
+				cursor = cursor == kNever ? consumer : std::max(cursor, consumer);
+			}
+		}
+		return cursor;
+	}
+
+	//! Drop the entries every consumer has seen
+	void truncate()
+	{
+		std::uint64_t cursor = end();
+		for(auto consumer : mCursors)
+		{
+			cursor = std::min(cursor, consumer);
+		}
+		mLog.erase(mLog.begin(), mLog.begin() + (cursor - mBase));
+		mBase = cursor;
+	}
+
+	const EntitySystem<Entity>& mSystem;
+	Property<Entity, std::uint64_t> mLastChange;
+	std::vector<Entity> mLog;
+	std::uint64_t mBase;
+	std::vector<std::uint64_t> mCursors;
+};
+
+template <class Entity_>
+constexpr std::uint64_t ChangeTracker<Entity_>::kNever;
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_CHANGETRACKER_H
@@ -56,6 +56,23 @@ public:
 		Parent::erase(whole);
 	}
 
+	void erase(const std::vector<Whole>& wholes) override
+	{
+		// parts are detached first, since in a self composition their erasure is deferred until the wholes are gone
+		std::vector<Part> parts;
+		for(auto const & whole : wholes)
+		{
+			Part current = Parent::firstPart(whole);
+			while(current != Part())
+			{
+				parts.push_back(current);
+				Parent::eraseAssociation(whole, current);
+				current = Parent::firstPart(whole);
+			}
+		}
+		Parent::mPartSystem.erase(parts);
+	}
+
 	void clear() override
 	{
 		std::vector<Part> toErase;
@@ -63,10 +80,7 @@ public:
 		             std::back_inserter(toErase), [this](const Part & p) -> bool {
 					return (Parent::whole(p) != Whole());
 				});
-		for(auto const & part : toErase)
-		{
-			Parent::mPartSystem.erase(part);
-		}
+		Parent::mPartSystem.erase(toErase);
 		Parent::clear();
 	}
 private:
@@ -25,37 +25,17 @@ namespace entity_system
 
 EntityBase::EntityBase() :
 	mId(std::numeric_limits<uint32_t>::max()),
-	mSystem(nullptr)
+	mGeneration(std::numeric_limits<uint32_t>::max())
 {
 
 }
 
-EntityBase::~EntityBase()
-{
-
-}
-
-bool EntityBase::operator==(const EntityBase &entity) const
-{
-	return mId == entity.mId && mSystem == entity.mSystem;
-}
-
-bool EntityBase::operator!=(const EntityBase &entity) const
-{
-	return !((*this) == entity);
-}
-
-EntityBase::EntityBase(uint32_t id, EntitySystemBase * system) :
+EntityBase::EntityBase(uint32_t id, uint32_t generation) :
 	mId(id),
-	mSystem(system)
+	mGeneration(generation)
 {
 
 }
 
-uint32_t EntitySystemBase::id(const EntityBase &en) const
-{
-	return en.mId;
-}
-
 } // namespace entity_system
 } // namespace ophidian
@@ -23,35 +23,65 @@
 #include <lemon/maps.h>
 #include <lemon/bits/vector_map.h>
 #include <lemon/list_graph.h>
+#include <ophidian/util/Range.h>
+#include <ophidian/util/MemoryResource.h>
+#include <ophidian/util/MemoryUsage.h>
+#include <ophidian/util/BinaryStream.h>
 #include <iostream>
 #include <vector>
 #include <deque>
+#include <limits>
+#include <cassert>
 
 namespace ophidian
 {
 namespace entity_system
 {
 class EntitySystemBase;
+
+//! Entity handler
+/*!
+   A generational handler with 8 bytes: the id of the slot the entity occupies in its EntitySystem and the generation of that slot when the entity was created.
+   A handler whose generation doesn't match the current generation of its slot refers to an erased entity.
+ */
 class EntityBase
 {
 public:
 	friend class EntitySystemBase;
-	explicit EntityBase(uint32_t id, EntitySystemBase* system);
+	explicit EntityBase(uint32_t id, uint32_t generation);
 	EntityBase();
-	~EntityBase();
-	bool operator==(const EntityBase& entity) const;
-	bool operator!=(const EntityBase& entity) const;
+	bool operator==(const EntityBase& entity) const
+	{
+		return mId == entity.mId && mGeneration == entity.mGeneration;
+	}
+	bool operator!=(const EntityBase& entity) const
+	{
+		return !((*this) == entity);
+	}
 private:
 	uint32_t mId;
-	EntitySystemBase* mSystem;
+	uint32_t mGeneration;
 };
 class EntitySystemBase
 {
 public:
-	uint32_t id(const EntityBase& en) const;
+	uint32_t id(const EntityBase& en) const
+	{
+		return en.mId;
+	}
+	uint32_t generation(const EntityBase& en) const
+	{
+		return en.mGeneration;
+	}
 };
 
 
+//! Tags of the binary blocks written by EntitySystems, Properties and Associations
+enum BinaryTag : uint16_t
+{
+	ENTITIES = 1, ENTITY_IDS, GENERATIONS, FREE_IDS, VALUES, PACKED_VALUES, FIRST_PARTS, NUMBER_OF_PARTS, NEXT_PARTS, PREVIOUS_PARTS, WHOLES
+};
+
 /*! Entity System Notifier */
 template <class EntitySystem_, class Entity_>
 class EntitySystemNotifier : public lemon::AlterationNotifier<EntitySystem_, Entity_>
@@ -66,12 +96,29 @@ public:
 protected:
 public:
 		using Parent::ObserverBase::ObserverBase;
-		virtual void erase(const std::vector<Entity> &items) final {
-		}
+		//! Erase many Entities
+		/*!
+		   \brief Called before \p items are erased, while every observer still holds its data. The storage itself is updated later, in compact(). Unlike erase() of one Entity, it is not called for each item, so every observer must handle it.
+		   \param items The Entities being erased, without repetitions.
+		 */
+		virtual void erase(const std::vector<Entity> &items) = 0;
+		using Parent::ObserverBase::erase;
 		virtual void build() final {
 		}
 		virtual void reserve(uint32_t size) = 0;
 		virtual void shrinkToFit() = 0;
+		//! Compact after erasing many Entities
+		/*!
+		   \brief Removes the data of erased Entities, keeping the relative order of the remaining ones.
+		   \param erased Flags indexed by Entity id, true for the erased Entities.
+		 */
+		virtual void compact(const std::vector<bool> &erased) = 0;
+		//! Permute Entities
+		/*!
+		   \brief Reorders the data of the Entities: the Entity at position order[i] moves to position i.
+		   \param order A permutation of the Entity positions.
+		 */
+		virtual void permute(const std::vector<uint32_t> &order) = 0;
 	};
 	using Parent::Parent;
 	void reserve(uint32_t size)
@@ -90,16 +137,32 @@ public:
 			observer->shrinkToFit();
 		}
 	}
+	void compact(const std::vector<bool> &erased)
+	{
+		for (auto it = Parent::_observers.begin(); it != Parent::_observers.end(); ++it)
+		{
+			auto observer = static_cast<ObserverBase*>(*it);
+			observer->compact(erased);
+		}
+	}
+	void permute(const std::vector<uint32_t> &order)
+	{
+		for (auto it = Parent::_observers.begin(); it != Parent::_observers.end(); ++it)
+		{
+			auto observer = static_cast<ObserverBase*>(*it);
+			observer->permute(order);
+		}
+	}
 	void erase(const Entity & item)
 	{
 		Parent::erase(item);
 	}
-private:
-	void build()
+	void erase(const std::vector<Entity> &items)
 	{
-
+		Parent::erase(items);
 	}
-	void erase(const std::vector<Entity> &items)
+private:
+	void build()
 	{
 
 	}
@@ -118,14 +181,23 @@ public:
 	using Entity = Entity_;
 	using NotifierType = EntitySystemNotifier<EntitySystem, Entity>;
 	using ContainerType = std::vector<Entity>;
-	using const_iterator = typename ContainerType::const_iterator;
-	using size_type = typename ContainerType::size_type;
+	using StorageType = std::vector<Entity, util::PolymorphicAllocator<Entity> >;
+	using IdContainerType = std::vector<uint32_t, util::PolymorphicAllocator<uint32_t> >;
+	using const_iterator = typename StorageType::const_iterator;
+	using size_type = typename StorageType::size_type;
 
 	//! Construct EntitySystem
 	/*!
 	   Constructs an empty EntitySystem, with no Entities.
+	   \param resource The MemoryResource for the storage of the EntitySystem and of the Properties attached to it. It must outlive them.
 	 */
-	EntitySystem()
+	explicit EntitySystem(util::MemoryResource* resource = util::defaultResource()) :
+		mContainer(util::PolymorphicAllocator<Entity>(resource)),
+		mId2Index(util::PolymorphicAllocator<uint32_t>(resource)),
+		mGenerations(util::PolymorphicAllocator<uint32_t>(resource)),
+		mFreeIds(util::PolymorphicAllocator<uint32_t>(resource)),
+		mErasing(false),
+		mResource(resource)
 	{
 		mNotifier.setContainer(*this);
 		mId = mIdCounter++;
@@ -137,18 +209,33 @@ public:
 
 	//! Add Entity
 	/*!
-	   \brief Creates an Entity instance.
+	   \brief Creates an Entity instance. Ids of erased entities are recycled, with a new generation.
 	   \return A handler for the created Entity.
 	 */
 	Entity add()
 	{
-		uint32_t id = mId2Index.size();
-		Entity entity(id, this);
-		mId2Index.push_back(mContainer.size());
+		Entity entity = acquire();
 		mContainer.push_back(entity);
 		mNotifier.add(mContainer.back());
 		return entity;
 	}
+	//! Add Entities
+	/*!
+	   \brief Creates \p n Entity instances, notifying the attached Properties only once.
+	   \param n The number of Entities to create.
+	   \return A range with the handlers of the created Entities, which are contiguous in the EntitySystem.
+	   \remarks The range is invalidated by the next addition or removal of Entities.
+	 */
+	util::Range<const_iterator> add(size_type n)
+	{
+		auto first = mContainer.size();
+		for(size_type i = 0; i < n; ++i)
+		{
+			mContainer.push_back(acquire());
+		}
+		mNotifier.add(ContainerType(mContainer.begin() + first, mContainer.end()));
+		return util::Range<const_iterator>(mContainer.begin() + first, mContainer.end());
+	}
 	//! Erase Entity
 	/*!
 	   \param entity A handler for the Entity to erase.
@@ -163,7 +250,30 @@ public:
 		std::swap(mContainer[index], mContainer.back());
 		mContainer.pop_back();
 		mId2Index[lastEntityId] = index;
-		mId2Index[entityId] = std::numeric_limits<uint32_t>::max();
+		retire(entityId);
+	}
+	//! Erase Entities
+	/*!
+	   \param entities A range of handlers for the Entities to erase. Repeated or invalid handlers are ignored.
+	   \brief Erases many Entity instances as well as their attached Properties. Observers are notified of all erased Entities at once, then the EntitySystem and each Property are compacted in a single linear pass that keeps the relative order of the remaining Entities.
+	   \remarks Erasures requested by observers while they are notified (e.g., a self Composition erasing parts) are deferred to another pass.
+	 */
+	template <class EntityRange>
+	void erase(const EntityRange& entities)
+	{
+		mPendingErasures.insert(mPendingErasures.end(), entities.begin(), entities.end());
+		if(mErasing)
+		{
+			return;
+		}
+		mErasing = true;
+		while(!mPendingErasures.empty())
+		{
+			ContainerType items;
+			items.swap(mPendingErasures);
+			eraseAndCompact(items);
+		}
+		mErasing = false;
 	}
 	//! Clear Entities
 	/*!
@@ -172,8 +282,30 @@ public:
 	void clear()
 	{
 		mNotifier.clear();
+		for(auto const & entity : mContainer)
+		{
+			retire(EntitySystemBase::id(entity));
+		}
 		mContainer.clear();
 	}
+	//! Permute Entities
+	/*!
+	   \brief Reorders the Entities and every attached Property consistently: the Entity at position order[i] moves to position i. Handlers stay valid.
+	   \param order A permutation of [0, size()), e.g., a locality-improving order.
+	 */
+	void permute(const std::vector<uint32_t>& order)
+	{
+		assert(order.size() == mContainer.size());
+		mNotifier.permute(order);
+		StorageType container(mContainer.get_allocator());
+		container.reserve(mContainer.capacity());
+		for(size_type index = 0; index < order.size(); ++index)
+		{
+			container.push_back(mContainer[order[index]]);
+			mId2Index[EntitySystemBase::id(container.back())] = index;
+		}
+		mContainer.swap(container);
+	}
 	//! Allocate space for storing Entities
 	/*!
 	   \brief Using this function, it is possible to avoid superfluous memory allocation: if you know that the EntitySystem you want to build will be large (e.g. it will contain millions entities), then it is worth reserving space for this amount before starting to build the EntitySystem.
@@ -237,8 +369,10 @@ public:
 	 */
 	bool valid(const Entity& entity) const
 	{
-		return EntitySystemBase::id(entity) != std::numeric_limits<uint32_t>::max() &&
-		       mId2Index[EntitySystemBase::id(entity)] < mContainer.size();
+		auto entityId = EntitySystemBase::id(entity);
+		return entityId < mId2Index.size() &&
+		       mGenerations[entityId] == EntitySystemBase::generation(entity) &&
+		       mId2Index[entityId] < mContainer.size();
 	}
 	//! Get the Notifier
 	/*!
@@ -251,13 +385,15 @@ public:
 	}
 	//! Entity id
 	/*!
-	   \brief Returns the id of an Entity.
+	   \brief Returns the id of an Entity, i.e., its position in the Entity container and in every attached Property.
 	   \param entity A handler to the Entity we want to get the id.
 	   \return The id of \p entity.
+	   \remarks The lookup is unchecked. Builds without NDEBUG assert that \p entity is valid.
 	 */
 	size_type id(const Entity& entity) const
 	{
-		return mId2Index.at(EntitySystemBase::id(entity));
+		assert(valid(entity));
+		return mId2Index[EntitySystemBase::id(entity)];
 	}
 	//! EntitySystem id
 	/*!
@@ -266,18 +402,155 @@ public:
 	uint32_t id() const {
 		return mId;
 	}
+	//! Memory Resource
+	/*!
+	   \return The MemoryResource used by the EntitySystem and by the Properties attached to it.
+	 */
+	util::MemoryResource* resource() const {
+		return mResource;
+	}
+	//! Memory usage
+	/*!
+	   \brief Reports the Entity container and the tables mapping Entity ids to indices, generations and free ids.
+	 */
+	util::MemoryUsage memoryUsage() const {
+		util::MemoryUsage usage("EntitySystem", mContainer.size(), mContainer.capacity(), mContainer.capacity() * sizeof(Entity));
+		usage.add("ids", util::memoryUsage(mId2Index));
+		usage.add("generations", util::memoryUsage(mGenerations));
+		usage.add("freeIds", util::memoryUsage(mFreeIds));
+		return usage;
+	}
+	//! Save EntitySystem
+	/*!
+	   \brief Writes the Entities and the id tables, so the handlers stay valid after load(). Attached Properties are saved separately.
+	   \param writer The destination of the binary blocks.
+	 */
+	void save(util::BinaryWriter& writer) const {
+		writer.write(ENTITIES, mContainer);
+		writer.write(ENTITY_IDS, mId2Index);
+		writer.write(GENERATIONS, mGenerations);
+		writer.write(FREE_IDS, mFreeIds);
+	}
+	//! Load EntitySystem
+	/*!
+	   \brief Replaces the Entities by the ones written by save(). The attached Properties are cleared and then resized with their default values, so they can be loaded next, in the order they were saved.
+	   \param reader The source of the binary blocks.
+	   \remarks Throws if the stream is not a saved EntitySystem; the EntitySystem is left empty in that case.
+	 */
+	void load(util::BinaryReader& reader) {
+		clear();
+		try {
+			reader.read(ENTITIES, mContainer);
+			reader.read(ENTITY_IDS, mId2Index);
+			reader.read(GENERATIONS, mGenerations);
+			reader.read(FREE_IDS, mFreeIds);
+			if(mGenerations.size() != mId2Index.size())
+			{
+				throw util::InvalidBinaryFormat();
+			}
+			for(size_type index = 0; index < mContainer.size(); ++index)
+			{
+				auto entityId = EntitySystemBase::id(mContainer[index]);
+				if(entityId >= mId2Index.size() || mId2Index[entityId] != index)
+				{
+					throw util::InvalidBinaryFormat();
+				}
+			}
+		} catch(...) {
+			mContainer.clear();
+			mId2Index.clear();
+			mGenerations.clear();
+			mFreeIds.clear();
+			throw;
+		}
+		if(!mContainer.empty())
+		{
+			mNotifier.add(ContainerType(mContainer.begin(), mContainer.end()));
+		}
+	}
 	//! Shrink EntitySystem
 	/*!
 	   \brief Reallocate the EntitySystem and it's propertys to have capacity == size. This may help to
 	 */
 	void shrinkToFit() {
 		mContainer.shrink_to_fit();
+		mFreeIds.shrink_to_fit();
 		mNotifier.shrinkToFit();
 	}
 private:
+	//! Take an id for a new Entity, reusing a retired one when available
+	Entity acquire()
+	{
+		uint32_t entityId;
+		if(mFreeIds.empty())
+		{
+			entityId = mId2Index.size();
+			mId2Index.push_back(mContainer.size());
+			mGenerations.push_back(0);
+		}
+		else
+		{
+			entityId = mFreeIds.back();
+			mFreeIds.pop_back();
+			mId2Index[entityId] = mContainer.size();
+		}
+		return Entity(entityId, mGenerations[entityId]);
+	}
+	//! Notify the erasure of \p entities and remove them, keeping the order of the remaining Entities
+	void eraseAndCompact(const ContainerType& entities)
+	{
+		std::vector<bool> erased(mContainer.size(), false);
+		ContainerType items;
+		for(auto const & entity : entities)
+		{
+			if(valid(entity) && !erased[id(entity)])
+			{
+				erased[id(entity)] = true;
+				items.push_back(entity);
+			}
+		}
+		if(items.empty())
+		{
+			return;
+		}
+		mNotifier.erase(items);
+		mNotifier.compact(erased);
+		size_type last = 0;
+		for(size_type index = 0; index < mContainer.size(); ++index)
+		{
+			if(erased[index])
+			{
+				retire(EntitySystemBase::id(mContainer[index]));
+				continue;
+			}
+			if(index != last)
+			{
+				mContainer[last] = mContainer[index];
+				mId2Index[EntitySystemBase::id(mContainer[last])] = last;
+			}
+			++last;
+		}
+		mContainer.resize(last);
+	}
+	//! Invalidate the handlers of an id and put it in the free list
+	void retire(uint32_t entityId)
+	{
+		mId2Index[entityId] = std::numeric_limits<uint32_t>::max();
+		// an id whose generation would wrap around is never reused, so stale handlers can't alias new entities
+		if(++mGenerations[entityId] != std::numeric_limits<uint32_t>::max())
+		{
+			mFreeIds.push_back(entityId);
+		}
+	}
+
 	NotifierType mNotifier;
-	ContainerType mContainer;
-	std::vector<size_type> mId2Index;
+	StorageType mContainer;
+	IdContainerType mId2Index;
+	IdContainerType mGenerations;
+	IdContainerType mFreeIds;
+	ContainerType mPendingErasures;
+	bool mErasing;
+	util::MemoryResource* mResource;
 	uint32_t mId;
 	static uint32_t mIdCounter;
 };
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_ERASER_H
+#define OPHIDIAN_ENTITY_SYSTEM_ERASER_H
+
+#include <functional>
+#include <vector>
+#include "EntitySystem.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Eraser
+/*!
+   Calls a function before each Entity of an EntitySystem is erased, so structures that refer to the Entity can drop it while its data is still there.
+   Observers attached later are notified first, so an Eraser declared after the Properties it reads still sees the data of the erased Entities.
+ */
+template <class Entity_>
+class Eraser :
+	public EntitySystem<Entity_>::NotifierType::ObserverBase
+{
+public:
+	using Entity = Entity_;
+
+	//! Construct Eraser
+	/*!
+	   \param notifier The notifier of the EntitySystem.
+	   \param function The function called with each erased Entity.
+	 */
+	Eraser(typename EntitySystem<Entity>::NotifierType & notifier, std::function<void(const Entity &)> function) :
+		EntitySystem<Entity>::NotifierType::ObserverBase(notifier),
+		mFunction(function)
+	{
+
+	}
+
+protected:
+	void add(const Entity &) override
+	{
+	}
+	void add(const std::vector<Entity> &) override
+	{
+	}
+	void erase(const Entity & item) override
+	{
+		mFunction(item);
+	}
+	void erase(const std::vector<Entity> & items) override
+	{
+		for(auto const & item : items)
+		{
+			mFunction(item);
+		}
+	}
+	void clear() override
+	{
+	}
+	void reserve(uint32_t) override
+	{
+	}
+	void shrinkToFit() override
+	{
+	}
+	void compact(const std::vector<bool> &) override
+	{
+	}
+	void permute(const std::vector<uint32_t> &) override
+	{
+	}
+
+private:
+	std::function<void(const Entity &)> mFunction;
+};
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_ERASER_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_JOURNAL_H
+#define OPHIDIAN_ENTITY_SYSTEM_JOURNAL_H
+
+#include <cassert>
+#include <utility>
+#include <vector>
+#include <ophidian/util/MemoryUsage.h>
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Undo log of a Property
+/*!
+   Records the values a Property had before being written, so they can be restored by rollback().
+   Checkpoints nest: rollback() and commit() act on the most recent one.
+ */
+template <class Entity_, class Value_>
+class Journal
+{
+public:
+	using Entity = Entity_;
+	using Value = Value_;
+	using Entry = std::pair<Entity, Value>;
+
+	//! Open a checkpoint
+	void checkpoint()
+	{
+		mCheckpoints.push_back(mEntries.size());
+	}
+
+	//! Active journal
+	/*!
+	   \return true if there is an open checkpoint, i.e., writes are being recorded.
+	 */
+	bool active() const
+	{
+		return !mCheckpoints.empty();
+	}
+
+	//! Record a value
+	/*!
+	   \brief Saves the value \p entity had before a write.
+	 */
+	void record(const Entity& entity, const Value& value)
+	{
+		mEntries.emplace_back(entity, value);
+	}
+
+	//! Roll back to the last checkpoint
+	/*!
+	   \brief Calls \p restore(entity, value) for every entry recorded since the last checkpoint, newest first, and closes the checkpoint.
+	 */
+	template <class Restore>
+	void rollback(Restore restore)
+	{
+		assert(active());
+		auto mark = mCheckpoints.back();
+		mCheckpoints.pop_back();
+		for(auto entry = mEntries.size(); entry > mark; --entry)
+		{
+			restore(mEntries[entry - 1].first, mEntries[entry - 1].second);
+		}
+		mEntries.erase(mEntries.begin() + mark, mEntries.end());
+		if(!active())
+		{
+			mEntries.clear();
+		}
+	}
+
+	//! Commit the last checkpoint
+	/*!
+	   \brief Closes the last checkpoint, keeping the changes. Its entries are kept while an enclosing checkpoint is open.
+	 */
+	void commit()
+	{
+		assert(active());
+		mCheckpoints.pop_back();
+		if(!active())
+		{
+			mEntries.clear();
+		}
+	}
+
+	//! Number of recorded entries
+	typename std::vector<Entry>::size_type size() const
+	{
+		return mEntries.size();
+	}
+
+	//! Memory usage
+	util::MemoryUsage memoryUsage() const
+	{
+		auto usage = util::memoryUsage(mEntries);
+		usage.bytes += mCheckpoints.capacity() * sizeof(typename std::vector<Entry>::size_type);
+		return usage;
+	}
+
+private:
+	std::vector<Entry> mEntries;
+	std::vector<typename std::vector<Entry>::size_type> mCheckpoints;
+};
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_JOURNAL_H
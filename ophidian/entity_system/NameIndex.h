@@ -0,0 +1,319 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_NAMEINDEX_H
+#define OPHIDIAN_ENTITY_SYSTEM_NAMEINDEX_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <ophidian/util/StringPool.h>
+#include "EntitySystem.h"
+#include "Property.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Name Index
+/*!
+   Names the Entities of an EntitySystem with strings interned in a util::StringPool, which may be shared by several systems.
+   Each Entity holds the 4-byte symbol of its name, and the Entity of each symbol is found in a compact open-addressing table keyed by the symbol, so names are stored once and looked up without hashing them again. The table only holds the names of this index, even when the pool is shared.
+   Erased Entities are skipped by the lookups, so a name is free again once its Entity is erased, whichever way it was erased.
+ */
+template <class Entity_>
+class NameIndex
+{
+public:
+	using Entity = Entity_;
+
+	//! Construct NameIndex
+	/*!
+	   \param system The EntitySystem of the named Entities.
+	   \param pool The pool of the names. It must outlive the NameIndex.
+	 */
+	NameIndex(const EntitySystem<Entity>& system, util::StringPool& pool) :
+		mSystem(&system),
+		mPool(&pool),
+		mSymbols(system, util::kInvalidSymbol),
+		mUsed(0)
+	{
+
+	}
+
+	//! Intern a name
+	/*!
+	   \return The symbol of \p name in the pool, adding it if needed.
+	 */
+	util::Symbol intern(util::StringView name)
+	{
+		return mPool->intern(name);
+	}
+
+	//! Entity of a symbol
+	/*!
+	   \return The Entity named \p symbol, or Entity() if there is none.
+	 */
+	Entity entity(util::Symbol symbol) const
+	{
+		if(mSlots.empty() || symbol == util::kInvalidSymbol)
+		{
+			return Entity();
+		}
+		auto const & slot = mSlots[find(symbol)];
+		if(slot.symbol != symbol || !mSystem->valid(slot.entity))
+		{
+			return Entity();
+		}
+		return slot.entity;
+	}
+
+	//! Find an Entity by name
+	/*!
+	   \return The Entity named \p name, or Entity() if there is none. Never allocates.
+	 */
+	Entity find(util::StringView name) const
+	{
+		return entity(mPool->find(name));
+	}
+
+	//! Name an Entity
+	/*!
+	   \brief Sets the name of \p entity to \p symbol. Neither the previous name of \p entity nor the previous Entity named \p symbol are found anymore.
+	 */
+	void assign(const Entity& entity, util::Symbol symbol)
+	{
+		auto previous = mSymbols[entity];
+		if(previous != util::kInvalidSymbol)
+		{
+			auto slot = find(previous);
+			if(mSlots[slot].symbol == previous && mSlots[slot].entity == entity)
+			{
+				erase(slot);
+			}
+		}
+		mSymbols[entity] = symbol;
+		reserve(1);
+		auto slot = find(symbol);
+		if(mSlots[slot].symbol != symbol)
+		{
+			mSlots[slot].symbol = symbol;
+			++mUsed;
+		}
+		mSlots[slot].entity = entity;
+	}
+
+	//! Add or get many named Entities
+	/*!
+	   \brief Returns the Entity of each name, creating the missing ones at once in \p system. Repeated names get the same Entity.
+	   \param system The EntitySystem of the named Entities.
+	   \param names The names.
+	 */
+	std::vector<Entity> add(EntitySystem<Entity>& system, const std::vector<std::string>& names)
+	{
+		std::vector<util::Symbol> symbols;
+		std::vector<util::Symbol> created;
+		std::unordered_set<util::Symbol> pending;
+		symbols.reserve(names.size());
+		for(auto const & name : names)
+		{
+			auto symbol = intern(name);
+			symbols.push_back(symbol);
+			if(entity(symbol) == Entity() && pending.insert(symbol).second)
+			{
+				created.push_back(symbol);
+			}
+		}
+
+		auto entities = system.add(created.size());
+		auto symbol = created.begin();
+		for(auto const & entity : entities)
+		{
+			assign(entity, *symbol++);
+		}
+
+		std::vector<Entity> result;
+		result.reserve(symbols.size());
+		for(auto symbol : symbols)
+		{
+			result.push_back(entity(symbol));
+		}
+		return result;
+	}
+
+	//! Symbol of an Entity
+	util::Symbol symbol(const Entity& entity) const
+	{
+		return mSymbols[entity];
+	}
+
+	//! Name of an Entity
+	/*!
+	   \return A view of the name of \p entity, valid until a new string is interned in the pool.
+	 */
+	util::StringView view(const Entity& entity) const
+	{
+		return mPool->view(mSymbols[entity]);
+	}
+
+	//! Name of an Entity
+	std::string name(const Entity& entity) const
+	{
+		return mPool->str(mSymbols[entity]);
+	}
+
+	//! Allocate space
+	/*!
+	   \brief Makes room for \p size more names without growing the table.
+	 */
+	void reserve(std::size_t size)
+	{
+		if((mUsed + size) * 4 > mSlots.size() * 3)
+		{
+			rehash(mUsed + size);
+		}
+	}
+
+	//! Pool of the names
+	const util::StringPool& pool() const
+	{
+		return *mPool;
+	}
+
+	//! Save names
+	/*!
+	   \brief Writes the names as strings, in EntitySystem order, so they can be loaded into another pool.
+	 */
+	void save(util::BinaryWriter& writer) const
+	{
+		std::vector<std::string> names;
+		names.reserve(mSystem->size());
+		for(auto const & entity : *mSystem)
+		{
+			names.push_back(name(entity));
+		}
+		writer.write(VALUES, names);
+	}
+
+	//! Load names
+	/*!
+	   \brief Reads the names written by save(), after the EntitySystem itself was loaded, interning them in the pool.
+	 */
+	void load(util::BinaryReader& reader)
+	{
+		std::vector<std::string> names;
+		reader.read(VALUES, names);
+		if(names.size() != mSystem->size())
+		{
+			throw util::InvalidBinaryFormat();
+		}
+		mSlots.assign(mSlots.size(), Slot());
+		mUsed = 0;
+		auto name = names.begin();
+		for(auto const & entity : *mSystem)
+		{
+			assign(entity, intern(*name++));
+		}
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the symbol of each Entity and the table of the Entity of each symbol. The pool is reported by its owner.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		util::MemoryUsage usage("NameIndex", mSystem->size(), mSystem->capacity());
+		usage.add("symbols", mSymbols.memoryUsage());
+		usage.add("entities", util::memoryUsage(mSlots));
+		return usage;
+	}
+
+private:
+	struct Slot
+	{
+		util::Symbol symbol = util::kInvalidSymbol;
+		Entity entity;
+	};
+
+	std::size_t home(util::Symbol symbol) const
+	{
+		// multiplying by an odd constant permutes the low bits, so consecutive symbols land in distinct slots
+		return (static_cast<std::size_t>(symbol) * 0x9E3779B1u) & (mSlots.size() - 1);
+	}
+
+	//! Slot of \p symbol, or the empty slot where it would be inserted
+	std::size_t find(util::Symbol symbol) const
+	{
+		auto mask = mSlots.size() - 1;
+		auto slot = home(symbol);
+		while(mSlots[slot].symbol != symbol && mSlots[slot].symbol != util::kInvalidSymbol)
+		{
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	//! Empties \p hole, shifting back the following entries of its probe sequence
+	void erase(std::size_t hole)
+	{
+		auto mask = mSlots.size() - 1;
+		for(auto next = (hole + 1) & mask; mSlots[next].symbol != util::kInvalidSymbol; next = (next + 1) & mask)
+		{
+			if(((next - home(mSlots[next].symbol)) & mask) >= ((next - hole) & mask))
+			{
+				mSlots[hole] = mSlots[next];
+				hole = next;
+			}
+		}
+		mSlots[hole] = Slot();
+		--mUsed;
+	}
+
+	//! Grows the table to hold \p size names, dropping the names of erased Entities
+	void rehash(std::size_t size)
+	{
+		std::size_t capacity = 16;
+		while(size * 4 > capacity * 3)
+		{
+			capacity *= 2;
+		}
+		std::vector<Slot> slots(capacity);
+		mSlots.swap(slots);
+		mUsed = 0;
+		for(auto const & slot : slots)
+		{
+			if(slot.symbol != util::kInvalidSymbol && mSystem->valid(slot.entity))
+			{
+				mSlots[find(slot.symbol)] = slot;
+				++mUsed;
+			}
+		}
+	}
+
+	const EntitySystem<Entity>* mSystem;
+	util::StringPool* mPool;
+	Property<Entity, util::Symbol> mSymbols;
+	std::vector<Slot> mSlots;
+	std::size_t mUsed;
+};
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_NAMEINDEX_H
@@ -0,0 +1,347 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_PACKEDPROPERTY_H
+#define OPHIDIAN_ENTITY_SYSTEM_PACKEDPROPERTY_H
+
+#include <cstdint>
+#include <ophidian/util/MemoryUsage.h>
+#include "EntitySystem.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Packed Property
+/*!
+   A Property for flags and small enumerations that stores each value in \p Bits_ bits, packing 64 / \p Bits_ values in each 64-bit word.
+   Besides reading and writing single values, it answers word-parallel queries, such as count() and forEach(), that test a whole word at a time with popcount and count-trailing-zeros.
+   Values are converted to and from their underlying integer with static_cast, so every value of \p Value_ must fit in \p Bits_ bits.
+   Unlike Property, writes are not journaled nor reported to a ChangeListener.
+ */
+template <class Entity_, class Value_, std::size_t Bits_ = 1>
+class PackedProperty :
+	public EntitySystem<Entity_>::NotifierType::ObserverBase
+{
+	static_assert(Bits_ == 1 || Bits_ == 2 || Bits_ == 4 || Bits_ == 8, "PackedProperty: Bits must divide the 64-bit word");
+public:
+	using Parent = typename EntitySystem<Entity_>::NotifierType::ObserverBase;
+	using Value = Value_;
+	using Entity = Entity_;
+	using Word = std::uint64_t;
+	using ContainerType = std::vector<Word, util::PolymorphicAllocator<Word> >;
+	static constexpr std::size_t kBits = Bits_;
+	static constexpr std::size_t kValuesPerWord = 64 / Bits_;
+
+	//! Proxy to the value of an Entity
+	class Reference
+	{
+public:
+		Reference(PackedProperty& property, std::size_t index) :
+			mProperty(property),
+			mIndex(index)
+		{
+
+		}
+		operator Value() const
+		{
+			return mProperty.value(mIndex);
+		}
+		Reference& operator=(const Value& value)
+		{
+			mProperty.value(mIndex, value);
+			return *this;
+		}
+		Reference& operator=(const Reference& other)
+		{
+			return (*this) = static_cast<Value>(other);
+		}
+private:
+		PackedProperty& mProperty;
+		const std::size_t mIndex;
+	};
+
+	PackedProperty(const EntitySystem<Entity_>& system, Value defaultValue = Value()) :
+		Parent(*system.notifier()),
+		mWords(util::PolymorphicAllocator<Word>(system.resource())),
+		mSystem(&system),
+		mSize(0),
+		mDefaultValue(defaultValue)
+	{
+		reserve(system.capacity());
+		resize(system.size());
+	}
+
+	~PackedProperty() override
+	{
+
+	}
+
+	Reference operator[](const Entity& entity)
+	{
+		return Reference(*this, mSystem->id(entity));
+	}
+	Value operator[](const Entity& entity) const
+	{
+		return value(mSystem->id(entity));
+	}
+
+	//! Count Entities with a value
+	/*!
+	   \brief Counts the Entities whose value is \p value, testing 64 / Bits values per instruction.
+	   \param value The value to count.
+	   \return The number of Entities whose value is \p value.
+	 */
+	std::size_t count(const Value& value) const
+	{
+		std::size_t total = 0;
+		auto pattern = broadcast(value);
+		for(std::size_t word = 0; word < mWords.size(); ++word)
+		{
+			total += __builtin_popcountll(matches(word, pattern));
+		}
+		return total;
+	}
+
+	//! Visit Entities with a value
+	/*!
+	   \brief Calls \p f(entity) for every Entity whose value is \p value, in EntitySystem order, skipping whole words without matches.
+	   \param value The value to look for.
+	   \param f The function to call.
+	 */
+	template <class Function>
+	void forEach(const Value& value, Function f) const
+	{
+		auto entities = mSystem->begin();
+		auto pattern = broadcast(value);
+		for(std::size_t word = 0; word < mWords.size(); ++word)
+		{
+			for(Word found = matches(word, pattern); found != 0; found &= found - 1)
+			{
+				f(entities[word * kValuesPerWord + __builtin_ctzll(found) / kBits]);
+			}
+		}
+	}
+
+	//! Packed words
+	/*!
+	   \brief Returns the packed words. The i-th Entity of the EntitySystem is stored in bits [(i % (64 / Bits)) * Bits, + Bits) of word i / (64 / Bits); unused trailing bits are zero.
+	 */
+	const ContainerType& words() const
+	{
+		return mWords;
+	}
+
+	std::size_t size() const
+	{
+		return mSize;
+	}
+	bool empty() const
+	{
+		return mSize == 0;
+	}
+
+	void reserve(std::uint32_t size) override
+	{
+		mWords.reserve(wordCount(size));
+	}
+
+	void shrinkToFit() override
+	{
+		mWords.shrink_to_fit();
+	}
+
+	//! Save PackedProperty
+	/*!
+	   \brief Writes the packed words.
+	 */
+	void save(util::BinaryWriter& writer) const
+	{
+		writer.write(PACKED_VALUES, mWords);
+	}
+
+	//! Load PackedProperty
+	/*!
+	   \brief Reads the words written by save(), after the EntitySystem itself was loaded. See Property::load().
+	 */
+	void load(util::BinaryReader& reader)
+	{
+		reader.read(PACKED_VALUES, mWords);
+		if(mWords.size() != wordCount(mSystem->size()))
+		{
+			mWords.clear();
+			mSize = 0;
+			resize(mSystem->size());
+			throw util::InvalidBinaryFormat();
+		}
+		mSize = mSystem->size();
+	}
+
+	//! Memory usage
+	util::MemoryUsage memoryUsage() const
+	{
+		return util::MemoryUsage("PackedProperty", mSize, mWords.capacity() * kValuesPerWord, mWords.capacity() * sizeof(Word));
+	}
+
+protected:
+	virtual void add(const Entity& item) override
+	{
+		resize(mSize + 1);
+	}
+	virtual void add(const std::vector<Entity>& items) override
+	{
+		resize(mSize + items.size());
+	}
+	virtual void erase(const Entity& item) override
+	{
+		auto index = mSystem->id(item);
+		value(index, value(mSize - 1));
+		resize(mSize - 1);
+	}
+	virtual void erase(const std::vector<Entity>& items) override
+	{
+		// the values are dropped in compact(), once every observer was notified
+	}
+	virtual void compact(const std::vector<bool>& erased) override
+	{
+		std::size_t last = 0;
+		for(std::size_t index = 0; index < mSize; ++index)
+		{
+			if(!erased[index])
+			{
+				value(last++, value(index));
+			}
+		}
+		resize(last);
+	}
+	virtual void permute(const std::vector<uint32_t>& order) override
+	{
+		ContainerType permuted(mWords.size(), 0, mWords.get_allocator());
+		for(std::size_t index = 0; index < order.size(); ++index)
+		{
+			permuted[index / kValuesPerWord] |= bits(value(order[index])) << shift(index);
+		}
+		mWords.swap(permuted);
+	}
+	virtual void clear() override
+	{
+		mWords.clear();
+		mSize = 0;
+	}
+
+private:
+	static constexpr Word kFieldMask = (Word(1) << Bits_) - 1;
+
+	static std::size_t wordCount(std::size_t size)
+	{
+		return (size + kValuesPerWord - 1) / kValuesPerWord;
+	}
+	static std::size_t shift(std::size_t index)
+	{
+		return (index % kValuesPerWord) * kBits;
+	}
+	static Word bits(const Value& value)
+	{
+		return static_cast<Word>(value) & kFieldMask;
+	}
+
+	//! A word with \p value repeated in every field
+	static Word broadcast(const Value& value)
+	{
+		// the lowest bit of every field times the value
+		return (~Word(0) / kFieldMask) * bits(value);
+	}
+
+	//! Mask with the lowest bit set in each field of \p word that equals \p pattern
+	Word matches(std::size_t word, Word pattern) const
+	{
+		// fields equal to the pattern become zero; fold each field onto its lowest bit
+		Word diff = mWords[word] ^ pattern;
+		Word folded = diff;
+		for(std::size_t bit = 1; bit < kBits; ++bit)
+		{
+			folded |= diff >> bit;
+		}
+		Word found = ~folded & (~Word(0) / kFieldMask);
+		auto used = mSize - word * kValuesPerWord;
+		if(used < kValuesPerWord)
+		{
+			found &= (Word(1) << shift(used)) - 1;
+		}
+		return found;
+	}
+
+	Value value(std::size_t index) const
+	{
+		return static_cast<Value>((mWords[index / kValuesPerWord] >> shift(index)) & kFieldMask);
+	}
+	void value(std::size_t index, const Value& value)
+	{
+		auto & word = mWords[index / kValuesPerWord];
+		word = (word & ~(kFieldMask << shift(index))) | (bits(value) << shift(index));
+	}
+
+	//! Resize to \p size values, filling new ones with the default value and zeroing the unused trailing bits
+	void resize(std::size_t size)
+	{
+		if(size < mSize)
+		{
+			mWords.resize(wordCount(size));
+			if(size % kValuesPerWord != 0)
+			{
+				mWords.back() &= (Word(1) << shift(size)) - 1;
+			}
+			mSize = size;
+			return;
+		}
+		mWords.resize(wordCount(size), 0);
+		if(bits(mDefaultValue) != 0)
+		{
+			for(std::size_t index = mSize; index < size; ++index)
+			{
+				value(index, mDefaultValue);
+			}
+		}
+		mSize = size;
+	}
+
+	ContainerType mWords;
+	const EntitySystem<Entity_>* mSystem;
+	std::size_t mSize;
+	Value mDefaultValue;
+};
+
+template <class Entity_, class Value_, std::size_t Bits_>
+constexpr std::size_t PackedProperty<Entity_, Value_, Bits_>::kBits;
+template <class Entity_, class Value_, std::size_t Bits_>
+constexpr std::size_t PackedProperty<Entity_, Value_, Bits_>::kValuesPerWord;
+template <class Entity_, class Value_, std::size_t Bits_>
+constexpr typename PackedProperty<Entity_, Value_, Bits_>::Word PackedProperty<Entity_, Value_, Bits_>::kFieldMask;
+
+//! Bit Property
+/*!
+   A PackedProperty of booleans, one bit per Entity.
+ */
+template <class Entity_>
+using BitProperty = PackedProperty<Entity_, bool, 1>;
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_PACKEDPROPERTY_H
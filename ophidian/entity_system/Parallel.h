@@ -0,0 +1,149 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_PARALLEL_H
+#define OPHIDIAN_ENTITY_SYSTEM_PARALLEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ophidian/util/Range.h>
+#include "EntitySystem.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Parallel iteration options
+/*!
+   \brief Controls how parallel_for_chunks and parallel_for_each split an EntitySystem among threads.
+ */
+struct ParallelOptions
+{
+	//! Construct ParallelOptions
+	/*!
+	   \param grainSize The number of Entities processed by each task.
+	   \param threads The number of threads, or 0 to use the OpenMP default.
+	 */
+	ParallelOptions(std::size_t grainSize = 1024, int threads = 0) :
+		grainSize(std::max<std::size_t>(grainSize, 1)),
+		threads(threads)
+	{
+
+	}
+
+	std::size_t grainSize;
+	int threads;
+};
+
+//! Number of threads
+/*!
+   \brief Returns the number of threads used with \p options, which is 1 when Ophidian is built without OpenMP.
+ */
+inline int parallelThreads(const ParallelOptions & options = ParallelOptions())
+{
+#ifdef _OPENMP
+	return options.threads > 0 ? options.threads : omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
+//! Parallel iteration over index ranges
+/*!
+   \brief Splits [0, size) into contiguous ranges of options.grainSize indices and calls \p function on each range, possibly in parallel.
+   \param size The number of indices.
+   \param function Called as function(first, last) for the indices [first, last). It must be safe to call concurrently and must not throw.
+   \param options The grain size and the number of threads.
+ */
+template <class Function>
+void parallel_for_range(std::size_t size, Function function, const ParallelOptions & options = ParallelOptions())
+{
+	const std::int64_t grain = options.grainSize;
+	const std::int64_t chunks = (static_cast<std::int64_t>(size) + grain - 1) / grain;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1) num_threads(parallelThreads(options)) if(chunks > 1)
+#endif
+	for(std::int64_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		const std::size_t first = chunk * grain;
+		function(first, std::min<std::size_t>(first + grain, size));
+	}
+}
+
+//! Parallel iteration over chunks
+/*!
+   \brief Splits the Entities of \p system into contiguous chunks of options.grainSize Entities and calls \p function on each chunk, possibly in parallel.
+   \param system The EntitySystem to iterate over.
+   \param function Called as function(chunk), where chunk is a util::Range of EntitySystem iterators. It must be safe to call concurrently and must not throw.
+   \param options The grain size and the number of threads.
+   \remarks The EntitySystem and its Properties must not be resized while iterating. The index of an Entity in its Properties is its distance to system.begin().
+ */
+template <class Entity_, class Function>
+void parallel_for_chunks(const EntitySystem<Entity_> & system, Function function, const ParallelOptions & options = ParallelOptions())
+{
+	using Chunk = util::Range<typename EntitySystem<Entity_>::const_iterator>;
+	const auto begin = system.begin();
+	parallel_for_range(system.size(), [&](std::size_t first, std::size_t last)
+	{
+		function(Chunk(begin + first, begin + last));
+	}, options);
+}
+
+//! Parallel iteration over Entities and Properties
+/*!
+   \brief Calls \p function on every Entity of \p system, possibly in parallel, along with the values of the zipped \p properties.
+   \param system The EntitySystem to iterate over.
+   \param function Called as function(entity, properties[entity]...). It must be safe to call concurrently and must not throw.
+   \param properties Dense Properties of \p system (with random access begin()), whose values are passed to \p function by reference.
+   \remarks Values are accessed by index, without a lookup per Entity.
+ */
+template <class Entity_, class Function, class ... Properties>
+void parallel_for_each(const ParallelOptions & options, const EntitySystem<Entity_> & system, Function function, Properties & ... properties)
+{
+	const auto begin = system.begin();
+	parallel_for_chunks(system, [&](const util::Range<typename EntitySystem<Entity_>::const_iterator> & chunk)
+	{
+		for(auto it = chunk.begin(); it != chunk.end(); ++it)
+		{
+			const auto index = it - begin;
+			// unused when no Properties are zipped
+			(void)index;
+			function(*it, properties.begin()[index] ...);
+		}
+	}, options);
+}
+
+//! Parallel iteration over Entities and Properties
+/*!
+   \brief Same as the overload taking ParallelOptions, with the default grain size and number of threads.
+ */
+template <class Entity_, class Function, class ... Properties>
+void parallel_for_each(const EntitySystem<Entity_> & system, Function function, Properties & ... properties)
+{
+	parallel_for_each(ParallelOptions(), system, function, properties ...);
+}
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_PARALLEL_H
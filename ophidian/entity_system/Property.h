@@ -21,11 +21,28 @@
 
 #include <lemon/maps.h>
 #include "EntitySystem.h"
+#include "Journal.h"
 
 namespace ophidian
 {
 namespace entity_system
 {
+
+//! Listener of Property writes
+/*!
+   Receives the Entities written through a Property, see Property::trackChanges().
+ */
+template <class Entity_>
+class ChangeListener
+{
+public:
+	virtual ~ChangeListener()
+	{
+
+	}
+	virtual void touch(const Entity_& entity) = 0;
+};
+
 template <class Entity_, class Value_>
 class Property :
 	public lemon::MapBase<Entity_, Value_>,
@@ -35,11 +52,14 @@ public:
 	using Parent = typename EntitySystem<Entity_>::NotifierType::ObserverBase;
 	using Value = Value_;
 	using Entity = Entity_;
-	using ContainerType = std::vector<Value>;
+	using ContainerType = std::vector<Value, util::PolymorphicAllocator<Value> >;
 
 	Property(const EntitySystem<Entity_>& system, Value defaultValue = Value()) :
 		Parent(*system.notifier()),
-		mDefaultValue(defaultValue)
+		mProperties(util::PolymorphicAllocator<Value>(system.resource())),
+		mSystem(&system),
+		mDefaultValue(defaultValue),
+		mListener(nullptr)
 	{
 		mProperties.reserve(system.capacity());
 		mProperties.resize(system.size());
@@ -47,7 +67,9 @@ public:
 	}
 
 	Property() :
-		Parent()
+		Parent(),
+		mSystem(nullptr),
+		mListener(nullptr)
 	{
 
 	}
@@ -55,6 +77,7 @@ public:
 	Property& operator=(const Property& o)
 	{
 		mProperties = o.mProperties;
+		mSystem = o.mSystem;
 		Parent::attach(*o.notifier());
 		return *this;
 	}
@@ -64,13 +87,35 @@ public:
 
 	}
 
+	//! Value of an Entity
+	/*!
+	   \brief Plain access to the value of \p entity. Writes through the returned reference are neither journaled nor reported to the ChangeListener; use set() for those.
+	 */
 	typename ContainerType::reference operator[](const Entity& entity)
 	{
-		return mProperties[Parent::notifier()->id(entity)];
+		return mProperties[mSystem->id(entity)];
 	}
 	typename ContainerType::const_reference operator[](const Entity& entity) const
 	{
-		return mProperties[Parent::notifier()->id(entity)];
+		return mProperties[mSystem->id(entity)];
+	}
+
+	//! Set the value of an Entity
+	/*!
+	   \brief The tracked write path: records the old value of \p entity while a checkpoint is open, reports \p entity to the ChangeListener, and stores \p value.
+	 */
+	void set(const Entity& entity, const Value& value)
+	{
+		auto index = mSystem->id(entity);
+		if(mJournal.active())
+		{
+			mJournal.record(entity, mProperties[index]);
+		}
+		if(mListener)
+		{
+			mListener->touch(entity);
+		}
+		mProperties[index] = value;
 	}
 
 	typename ContainerType::iterator begin()
@@ -114,6 +159,107 @@ public:
 		return mProperties.capacity();
 	}
 
+	//! Memory usage
+	/*!
+	   \brief Reports the values, including the heap buffers they own (e.g., long strings), and the journal when it holds entries.
+	   \remarks Costs O(size) for values that own heap buffers.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		auto usage = util::memoryUsage(mProperties);
+		usage.name = "Property";
+		if(mJournal.size() != 0)
+		{
+			usage.add("journal", mJournal.memoryUsage());
+		}
+		return usage;
+	}
+
+	//! Save Property
+	/*!
+	   \brief Writes the values, in EntitySystem order. Trivially copyable values are dumped as one array; strings get a length-prefixed encoding.
+	   \param writer The destination of the binary blocks.
+	   \param tag The tag of the block, checked by load().
+	 */
+	void save(util::BinaryWriter& writer, uint16_t tag = VALUES) const
+	{
+		writer.write(tag, mProperties);
+	}
+
+	//! Load Property
+	/*!
+	   \brief Reads the values written by save(), after the EntitySystem itself was loaded. Loading is neither journaled nor reported to the ChangeListener.
+	   \param reader The source of the binary blocks.
+	   \param tag The tag the block was saved with.
+	   \remarks Throws util::InvalidBinaryFormat if the number of values differs from the size of the EntitySystem.
+	 */
+	void load(util::BinaryReader& reader, uint16_t tag = VALUES)
+	{
+		reader.read(tag, mProperties);
+		if(mProperties.size() != mSystem->size())
+		{
+			mProperties.assign(mSystem->size(), mDefaultValue);
+			throw util::InvalidBinaryFormat();
+		}
+	}
+
+	//! Open a checkpoint
+	/*!
+	   \brief Starts recording the old value of every Entity written through set(), so the Property can be rolled back to this point. Checkpoints nest.
+	   \remarks Writes through operator[] and iterators are not recorded.
+	 */
+	void checkpoint()
+	{
+		mJournal.checkpoint();
+	}
+
+	//! Roll back to the last checkpoint
+	/*!
+	   \brief Restores the values written since the last checkpoint and closes it. Costs O(recorded writes). Entities erased in the meantime are skipped.
+	 */
+	void rollback()
+	{
+		mJournal.rollback([this](const Entity& entity, const Value& value)
+		{
+			if(mSystem->valid(entity))
+			{
+				mProperties[mSystem->id(entity)] = value;
+				if(mListener)
+				{
+					mListener->touch(entity);
+				}
+			}
+		});
+	}
+
+	//! Commit the last checkpoint
+	/*!
+	   \brief Keeps the values written since the last checkpoint and closes it. Recording stops when no checkpoint is left open.
+	 */
+	void commit()
+	{
+		mJournal.commit();
+	}
+
+	//! Journaling Property
+	/*!
+	   \return true if there is an open checkpoint.
+	 */
+	bool journaling() const
+	{
+		return mJournal.active();
+	}
+
+	//! Track changes
+	/*!
+	   \brief Reports every Entity written through set(), or restored by rollback(), to \p listener (e.g., a ChangeTracker).
+	   \param listener The listener, or nullptr to stop tracking. It must outlive the Property or be detached first.
+	 */
+	void trackChanges(ChangeListener<Entity>* listener)
+	{
+		mListener = listener;
+	}
+
 protected:
 
 	virtual void add(const Entity& item) override
@@ -126,9 +272,41 @@ protected:
 	}
 	virtual void erase(const Entity& item) override
 	{
-		std::swap(mProperties.back(), mProperties[Parent::notifier()->id(item)]);
+		std::swap(mProperties.back(), mProperties[mSystem->id(item)]);
 		mProperties.pop_back();
 	}
+	virtual void erase(const std::vector<Entity>& items) override
+	{
+		// the values are dropped in compact(), once every observer was notified
+	}
+	virtual void compact(const std::vector<bool>& erased) override
+	{
+		typename ContainerType::size_type last = 0;
+		for(typename ContainerType::size_type index = 0; index < mProperties.size(); ++index)
+		{
+			if(erased[index])
+			{
+				continue;
+			}
+			if(index != last)
+			{
+				mProperties[last] = std::move(mProperties[index]);
+			}
+			++last;
+		}
+		mProperties.erase(mProperties.begin() + last, mProperties.end());
+	}
+
+	virtual void permute(const std::vector<uint32_t>& order) override
+	{
+		ContainerType properties(mProperties.get_allocator());
+		properties.reserve(mProperties.capacity());
+		for(auto index : order)
+		{
+			properties.push_back(std::move(mProperties[index]));
+		}
+		mProperties.swap(properties);
+	}
 
 	virtual void clear() override
 	{
@@ -137,8 +315,11 @@ protected:
 
 protected:
 	ContainerType mProperties;
+	const EntitySystem<Entity_>* mSystem;
 private:
 	const Value mDefaultValue;
+	Journal<Entity, Value> mJournal;
+	ChangeListener<Entity>* mListener;
 };
 } // namespace entity_system
 } // namespace ophidian
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_SOAPROPERTY_H
+#define OPHIDIAN_ENTITY_SYSTEM_SOAPROPERTY_H
+
+#include <array>
+#include <string>
+#include <utility>
+#include <ophidian/util/MemoryResource.h>
+#include <ophidian/util/AlignedAllocator.h>
+#include "EntitySystem.h"
+#include "Journal.h"
+#include "Property.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Fields of a compound value
+/*!
+   Describes how SoAProperty splits a Value into scalar fields. Specializations must provide:
+   - Field, the scalar type stored for each field;
+   - fields, the number of fields;
+   - static Field get(const Value&, std::size_t field);
+   - static Value make(const std::array<Field, fields>&).
+ */
+template <class Value_>
+struct SoAFields;
+
+//! Structure-of-arrays Property
+/*!
+   A Property for compound values that stores each field of the value in its own contiguous array, aligned to 64 bytes.
+   Kernels can stream a single field with data(field), where the i-th element belongs to the i-th Entity of the EntitySystem.
+   operator[] returns a proxy that converts to and assigns from Value, so it can replace a Property<Entity, Value> in most code.
+ */
+template <class Entity_, class Value_, class Fields_ = SoAFields<Value_> >
+class SoAProperty :
+	public EntitySystem<Entity_>::NotifierType::ObserverBase
+{
+public:
+	using Parent = typename EntitySystem<Entity_>::NotifierType::ObserverBase;
+	using Value = Value_;
+	using Entity = Entity_;
+	using Fields = Fields_;
+	using Field = typename Fields::Field;
+	using FieldAllocator = util::AlignedAllocator<Field, 64>;
+	using FieldContainer = std::vector<Field, FieldAllocator>;
+	static constexpr std::size_t kFields = Fields::fields;
+
+	//! Proxy to the value of an Entity
+	class Reference
+	{
+public:
+		Reference(SoAProperty& property, std::size_t index) :
+			mProperty(property),
+			mIndex(index)
+		{
+
+		}
+		operator Value() const
+		{
+			return mProperty.value(mIndex);
+		}
+		Reference& operator=(const Value& value)
+		{
+			mProperty.value(mIndex, value);
+			return *this;
+		}
+		Reference& operator=(const Reference& other)
+		{
+			return (*this) = static_cast<Value>(other);
+		}
+		Field& field(std::size_t field)
+		{
+			return mProperty.mFields[field][mIndex];
+		}
+private:
+		SoAProperty& mProperty;
+		const std::size_t mIndex;
+	};
+
+	SoAProperty(const EntitySystem<Entity_>& system, Value defaultValue = Value()) :
+		Parent(*system.notifier()),
+		mSystem(&system),
+		mFields(makeFields(system.resource(), std::make_index_sequence<kFields>())),
+		mListener(nullptr)
+	{
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			mDefaultValue[field] = Fields::get(defaultValue, field);
+			mFields[field].reserve(system.capacity());
+			mFields[field].assign(system.size(), mDefaultValue[field]);
+		}
+	}
+
+	~SoAProperty() override
+	{
+
+	}
+
+	//! Value of an Entity
+	/*!
+	   \brief Plain access to the value of \p entity. Writes through the proxy are neither journaled nor reported to the ChangeListener; use set() for those.
+	 */
+	Reference operator[](const Entity& entity)
+	{
+		return Reference(*this, mSystem->id(entity));
+	}
+	Value operator[](const Entity& entity) const
+	{
+		return value(mSystem->id(entity));
+	}
+
+	//! Set the value of an Entity
+	/*!
+	   \brief The tracked write path, see Property::set().
+	 */
+	void set(const Entity& entity, const Value& newValue)
+	{
+		auto index = mSystem->id(entity);
+		if(mJournal.active())
+		{
+			mJournal.record(entity, value(index));
+		}
+		if(mListener)
+		{
+			mListener->touch(entity);
+		}
+		value(index, newValue);
+	}
+
+	//! Field array
+	/*!
+	   \brief Returns the contiguous, 64-byte aligned array of a field, indexed like the Entities of the EntitySystem.
+	   \param field The index of the field.
+	   \remarks The pointer is invalidated when Entities are added or erased.
+	 */
+	Field* data(std::size_t field)
+	{
+		return mFields[field].data();
+	}
+	const Field* data(std::size_t field) const
+	{
+		return mFields[field].data();
+	}
+
+	std::size_t size() const
+	{
+		return mFields[0].size();
+	}
+	bool empty() const
+	{
+		return mFields[0].empty();
+	}
+
+	void reserve(std::uint32_t size) override
+	{
+		for(auto & field : mFields)
+		{
+			field.reserve(size);
+		}
+	}
+
+	void shrinkToFit() override
+	{
+		for(auto & field : mFields)
+		{
+			field.shrink_to_fit();
+		}
+	}
+
+	std::uint32_t capacity() const
+	{
+		return mFields[0].capacity();
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports each field array and the journal when it holds entries.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		util::MemoryUsage usage("SoAProperty", size(), capacity());
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			usage.add("field" + std::to_string(field), util::memoryUsage(mFields[field]));
+		}
+		if(mJournal.size() != 0)
+		{
+			usage.add("journal", mJournal.memoryUsage());
+		}
+		return usage;
+	}
+
+	//! Open a checkpoint
+	/*!
+	   \brief Starts recording the old value of every Entity written through set(). Writes through operator[] and data() are not recorded. See Property::checkpoint().
+	 */
+	void checkpoint()
+	{
+		mJournal.checkpoint();
+	}
+
+	//! Roll back to the last checkpoint
+	void rollback()
+	{
+		mJournal.rollback([this](const Entity& entity, const Value& old)
+		{
+			if(mSystem->valid(entity))
+			{
+				value(mSystem->id(entity), old);
+				if(mListener)
+				{
+					mListener->touch(entity);
+				}
+			}
+		});
+	}
+
+	//! Commit the last checkpoint
+	void commit()
+	{
+		mJournal.commit();
+	}
+
+	//! Journaling Property
+	bool journaling() const
+	{
+		return mJournal.active();
+	}
+
+	//! Track changes
+	/*!
+	   \brief Reports every Entity written through set(), or restored by rollback(), to \p listener. See Property::trackChanges().
+	 */
+	void trackChanges(ChangeListener<Entity>* listener)
+	{
+		mListener = listener;
+	}
+
+protected:
+	virtual void add(const Entity& item) override
+	{
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			mFields[field].push_back(mDefaultValue[field]);
+		}
+	}
+	virtual void add(const std::vector<Entity>& items) override
+	{
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			mFields[field].resize(mFields[field].size() + items.size(), mDefaultValue[field]);
+		}
+	}
+	virtual void erase(const Entity& item) override
+	{
+		auto index = mSystem->id(item);
+		for(auto & field : mFields)
+		{
+			std::swap(field.back(), field[index]);
+			field.pop_back();
+		}
+	}
+	virtual void erase(const std::vector<Entity>& items) override
+	{
+		// the values are dropped in compact(), once every observer was notified
+	}
+	virtual void compact(const std::vector<bool>& erased) override
+	{
+		for(auto & field : mFields)
+		{
+			std::size_t last = 0;
+			for(std::size_t index = 0; index < field.size(); ++index)
+			{
+				if(!erased[index])
+				{
+					field[last++] = field[index];
+				}
+			}
+			field.resize(last);
+		}
+	}
+	virtual void permute(const std::vector<uint32_t>& order) override
+	{
+		for(auto & field : mFields)
+		{
+			FieldContainer permuted(field.get_allocator());
+			permuted.reserve(field.capacity());
+			for(auto index : order)
+			{
+				permuted.push_back(field[index]);
+			}
+			field.swap(permuted);
+		}
+	}
+	virtual void clear() override
+	{
+		for(auto & field : mFields)
+		{
+			field.clear();
+		}
+	}
+
+private:
+	template <std::size_t... Indices>
+	static std::array<FieldContainer, kFields> makeFields(util::MemoryResource* resource, std::index_sequence<Indices...>)
+	{
+		return {{((void)Indices, FieldContainer(FieldAllocator(resource)))...}};
+	}
+
+	Value value(std::size_t index) const
+	{
+		std::array<Field, kFields> fields;
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			fields[field] = mFields[field][index];
+		}
+		return Fields::make(fields);
+	}
+
+	void value(std::size_t index, const Value& value)
+	{
+		for(std::size_t field = 0; field < kFields; ++field)
+		{
+			mFields[field][index] = Fields::get(value, field);
+		}
+	}
+
+	const EntitySystem<Entity_>* mSystem;
+	std::array<FieldContainer, kFields> mFields;
+	std::array<Field, kFields> mDefaultValue;
+	Journal<Entity, Value> mJournal;
+	ChangeListener<Entity>* mListener;
+};
+
+template <class Entity_, class Value_, class Fields_>
+constexpr std::size_t SoAProperty<Entity_, Value_, Fields_>::kFields;
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_SOAPROPERTY_H
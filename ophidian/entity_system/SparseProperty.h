@@ -0,0 +1,228 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_ENTITY_SYSTEM_SPARSEPROPERTY_H
+#define OPHIDIAN_ENTITY_SYSTEM_SPARSEPROPERTY_H
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include "EntitySystem.h"
+
+namespace ophidian
+{
+namespace entity_system
+{
+
+//! Sparse Property
+/*!
+   A Property for attributes that only a few Entities have. Only the Entities that were set hold a value; the others read the default value.
+   The values are kept in a dense vector of (Entity, Value) pairs, indexed by a hash table on the Entity id, so iteration only visits the set entries.
+   Like Property, it follows the lifecycle of its EntitySystem: erasing an Entity also erases its value.
+ */
+template <class Entity_, class Value_>
+class SparseProperty :
+	public EntitySystem<Entity_>::NotifierType::ObserverBase
+{
+public:
+	using Parent = typename EntitySystem<Entity_>::NotifierType::ObserverBase;
+	using Value = Value_;
+	using Entity = Entity_;
+	using Entry = std::pair<Entity, Value>;
+	using ContainerType = std::vector<Entry, util::PolymorphicAllocator<Entry> >;
+
+	//! Construct SparseProperty
+	/*!
+	   \brief Constructs an empty SparseProperty attached to \p system.
+	   \param system The EntitySystem of the Entities.
+	   \param defaultValue The value read for the Entities that were not set.
+	 */
+	SparseProperty(const EntitySystem<Entity_>& system, Value defaultValue = Value()) :
+		Parent(*system.notifier()),
+		mSystem(&system),
+		mSlots(SlotMap::allocator_type(system.resource())),
+		mEntries(util::PolymorphicAllocator<Entry>(system.resource())),
+		mDefaultValue(defaultValue)
+	{
+
+	}
+
+	~SparseProperty() override
+	{
+
+	}
+
+	//! Value of an Entity
+	/*!
+	   \brief Returns the value of \p entity, or the default value if \p entity was not set.
+	   \param entity A handler for the Entity.
+	 */
+	const Value& operator[](const Entity& entity) const
+	{
+		auto slot = mSlots.find(key(entity));
+		if(slot == mSlots.end())
+		{
+			return mDefaultValue;
+		}
+		return mEntries[slot->second].second;
+	}
+
+	//! Value of an Entity
+	/*!
+	   \brief Returns a reference to the value of \p entity, setting it to the default value first if it was not set.
+	   \param entity A handler for the Entity.
+	 */
+	Value& operator[](const Entity& entity)
+	{
+		auto inserted = mSlots.emplace(key(entity), static_cast<uint32_t>(mEntries.size()));
+		if(inserted.second)
+		{
+			mEntries.emplace_back(entity, mDefaultValue);
+		}
+		return mEntries[inserted.first->second].second;
+	}
+
+	//! Has value
+	/*!
+	   \brief Checks whether \p entity was set.
+	   \param entity A handler for the Entity.
+	   \return true if \p entity holds a value, false otherwise.
+	 */
+	bool has(const Entity& entity) const
+	{
+		return mSlots.find(key(entity)) != mSlots.end();
+	}
+
+	//! Reset the value of an Entity
+	/*!
+	   \brief Removes the value of \p entity, if any, so it reads the default value again.
+	   \param entity A handler for the Entity.
+	 */
+	void reset(const Entity& entity)
+	{
+		auto slot = mSlots.find(key(entity));
+		if(slot == mSlots.end())
+		{
+			return;
+		}
+		uint32_t index = slot->second;
+		mSlots.erase(slot);
+		if(index + 1 != mEntries.size())
+		{
+			mEntries[index] = std::move(mEntries.back());
+			mSlots[key(mEntries[index].first)] = index;
+		}
+		mEntries.pop_back();
+	}
+
+	typename ContainerType::iterator begin()
+	{
+		return mEntries.begin();
+	}
+	typename ContainerType::iterator end()
+	{
+		return mEntries.end();
+	}
+	typename ContainerType::const_iterator begin() const
+	{
+		return mEntries.begin();
+	}
+	typename ContainerType::const_iterator end() const
+	{
+		return mEntries.end();
+	}
+
+	//! Number of set Entities
+	typename ContainerType::size_type size() const
+	{
+		return mEntries.size();
+	}
+	bool empty() const
+	{
+		return mEntries.empty();
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the entries and the hash table that indexes them.
+	 */
+	util::MemoryUsage memoryUsage() const
+	{
+		util::MemoryUsage usage("SparseProperty", mEntries.size(), mEntries.capacity());
+		usage.add("entries", util::memoryUsage(mEntries));
+		usage.add("slots", util::memoryUsage(mSlots));
+		return usage;
+	}
+
+	void reserve(std::uint32_t size) override
+	{
+	}
+
+	void shrinkToFit() override
+	{
+		mEntries.shrink_to_fit();
+	}
+
+protected:
+	virtual void add(const Entity& item) override
+	{
+	}
+	virtual void add(const std::vector<Entity>& items) override
+	{
+	}
+	virtual void erase(const Entity& item) override
+	{
+		reset(item);
+	}
+	virtual void erase(const std::vector<Entity>& items) override
+	{
+		for(auto const & item : items)
+		{
+			reset(item);
+		}
+	}
+	virtual void compact(const std::vector<bool>& erased) override
+	{
+	}
+	virtual void permute(const std::vector<uint32_t>& order) override
+	{
+	}
+	virtual void clear() override
+	{
+		mSlots.clear();
+		mEntries.clear();
+	}
+
+private:
+	using SlotMap = std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>, util::PolymorphicAllocator<std::pair<const uint32_t, uint32_t> > >;
+
+	uint32_t key(const Entity& entity) const
+	{
+		return mSystem->EntitySystemBase::id(entity);
+	}
+
+	const EntitySystem<Entity_>* mSystem;
+	SlotMap mSlots;
+	ContainerType mEntries;
+	const Value mDefaultValue;
+};
+
+} // namespace entity_system
+} // namespace ophidian
+
+#endif // OPHIDIAN_ENTITY_SYSTEM_SPARSEPROPERTY_H
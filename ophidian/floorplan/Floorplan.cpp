@@ -24,10 +24,13 @@ namespace ophidian
 namespace floorplan
 {
 
-Floorplan::Floorplan()
-	: mChipOrigin(0.0, 0.0), mChipUpperRightCorner(0.0, 0.0),
-	mOrigins(mRows), mNumberOfSites(mRows), mSiteTypeOfRow(mRows),
-	mNames(mSites), mDimensions(mSites)
+Floorplan::Floorplan(util::MemoryResource* resource, util::StringPool* names)
+	: mRows(resource),
+	mOwnedNamePool(names ? nullptr : new util::StringPool),
+	mNamePool(names ? names : mOwnedNamePool.get()),
+	mSites(resource),
+	mNames(mSites, *mNamePool), mDimensions(mSites),
+	mChipOrigin(0.0, 0.0), mChipUpperRightCorner(0.0, 0.0)
 {
 
 }
@@ -47,28 +50,22 @@ void Floorplan::chipUpperRightCorner(const util::LocationDbu &loc)
 	mChipUpperRightCorner = loc;
 }
 
-Site Floorplan::add(Site, const std::string & name, const util::LocationDbu & loc)
+Site Floorplan::add(Site, util::StringView name, const util::LocationDbu & loc)
 {
 	auto site = mSites.add();
-	mNames[site] = name;
-	mName2Site[name] = site;
+	mNames.assign(site, mNames.intern(name));
 	mDimensions[site] = loc;
 	return site;
 }
 
 void Floorplan::erase(Site site)
 {
-	mName2Site.erase(name(site));
 	mSites.erase(site);
 }
 
 Row Floorplan::add(Row, const util::LocationDbu &loc, size_t num, const Site &site)
 {
-	auto row = mRows.add();
-	mOrigins[row] = loc;
-	mNumberOfSites[row] = num;
-	mSiteTypeOfRow[row] = site;
-	return row;
+	return mRows.emplace(loc, num, site);
 }
 
 void Floorplan::erase(const Row &row)
@@ -78,12 +75,26 @@ void Floorplan::erase(const Row &row)
 
 util::LocationDbu Floorplan::rowUpperRightCorner(const Row &row) const
 {
-	auto site = mSiteTypeOfRow[row];
-	size_t numSites = mNumberOfSites[row];
+	auto site = mRows.get<SITE_TYPE>(row);
+	size_t numSites = mRows.get<NUMBER_OF_SITES>(row);
 	util::LocationDbu uRCorner = mDimensions[site];
 	return util::LocationDbu(uRCorner.x() * numSites, uRCorner.y());
 }
 
+util::MemoryUsage Floorplan::memoryUsage() const
+{
+	util::MemoryUsage usage("Floorplan");
+	usage.add("rows", mRows.memoryUsage());
+	usage.add("sites", mSites.memoryUsage());
+	usage.add("names", mNames.memoryUsage());
+	usage.add("dimensions", mDimensions.memoryUsage());
+	if(mOwnedNamePool)
+	{
+		usage.add("namePool", mOwnedNamePool->memoryUsage());
+	}
+	return usage;
+}
+
 } //namespace floorplan
 
 } //namespace ophidian
@@ -21,9 +21,11 @@
 
 #include <ophidian/entity_system/EntitySystem.h>
 #include <ophidian/entity_system/Property.h>
+#include <ophidian/entity_system/Archetype.h>
+#include <ophidian/entity_system/NameIndex.h>
 #include <ophidian/util/Range.h>
 #include <ophidian/util/Units.h>
-#include <unordered_map>
+#include <memory>
 
 namespace ophidian
 {
@@ -57,8 +59,10 @@ public:
 	//! Floorplan Constructor
 	/*!
 	   \brief Constructs a floorplan system with no properties
+	   \param resource The MemoryResource for the EntitySystems and Properties. It must outlive the Floorplan.
+	   \param names The StringPool where the names of Sites are interned. It must outlive the Floorplan. If null, the Floorplan owns its own pool.
 	 */
-	Floorplan();
+	explicit Floorplan(util::MemoryResource* resource = util::defaultResource(), util::StringPool* names = nullptr);
 
 	//! Floorplan Destructor
 	/*!
@@ -109,7 +113,7 @@ public:
 	   \param dimension LocationDbu describing the site dimension.
 	   \return The created site.
 	 */
-	Site add(Site, const std::string & name, const util::LocationDbu & loc);
+	Site add(Site, util::StringView name, const util::LocationDbu & loc);
 
 	//! Erase site in the floorplan
 	/*!
@@ -127,18 +131,18 @@ public:
 	 */
 	std::string name(const Site & site) const
 	{
-		return mNames[site];
+		return mNames.name(site);
 	}
 
 	//! Site getter
 	/*!
-	   \brief Get the site of a given site name
+	   \brief Get the site of a given site name. Does not allocate, and does not add missing names.
 	   \param A name of a site.
-	   \return Site entity of the given name.
+	   \return Site entity of the given name, or Site() if there is no such site.
 	 */
-	Site find(std::string siteName)
+	Site find(util::StringView siteName) const
 	{
-		return mName2Site[siteName];
+		return mNames.find(siteName);
 	}
 
 	//! Site Upper right corner getter
@@ -188,7 +192,7 @@ public:
 	 */
 	util::LocationDbu origin(const Row & row) const
 	{
-		return mOrigins[row];
+		return mRows.get<ORIGIN>(row);
 	}
 
 	//! Number of sites getter
@@ -199,7 +203,7 @@ public:
 	 */
 	size_t numberOfSites(const Row & row) const
 	{
-		return mNumberOfSites[row];
+		return mRows.get<NUMBER_OF_SITES>(row);
 	}
 
 	//! Site type getter
@@ -210,7 +214,7 @@ public:
 	 */
 	Site site(const Row & row) const
 	{
-		return mSiteTypeOfRow[row];
+		return mRows.get<SITE_TYPE>(row);
 	}
 
 	//! Rows iterator
@@ -230,20 +234,30 @@ public:
 	 */
 	util::LocationDbu rowUpperRightCorner(const Row & row) const;
 
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by the Floorplan: the Row and Site EntitySystems, their Properties, the Site name index and the StringPool, unless it was given to the constructor.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
 private:
-	entity_system::EntitySystem<Row> mRows;
-	entity_system::Property<Row, util::LocationDbu> mOrigins;
-	entity_system::Property<Row, size_t> mNumberOfSites;
-	entity_system::Property<Row, Site> mSiteTypeOfRow;
+	//! Components of a Row
+	enum RowComponent
+	{
+		ORIGIN, NUMBER_OF_SITES, SITE_TYPE
+	};
+
+	entity_system::Archetype<Row, util::LocationDbu, size_t, Site> mRows;
+
+	std::unique_ptr<util::StringPool> mOwnedNamePool;
+	util::StringPool* mNamePool;
 
 	entity_system::EntitySystem<Site> mSites;
-	entity_system::Property<Site, std::string> mNames;
+	entity_system::NameIndex<Site> mNames;
 	entity_system::Property<Site, util::LocationDbu> mDimensions;
 
 	util::LocationDbu mChipOrigin;
 	util::LocationDbu mChipUpperRightCorner;
-
-	std::unordered_map<std::string, Site> mName2Site;
 };
 
 } //namespace floorplan
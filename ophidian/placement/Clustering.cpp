@@ -0,0 +1,75 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Clustering.h"
+
+namespace ophidian
+{
+namespace placement
+{
+
+void placeClusters(const circuit::Clustering & clustering, const Placement & placement, Placement & clusters)
+{
+	const auto & netlist = clustering.netlist();
+	for(auto cluster = netlist.begin(circuit::Cell()); cluster != netlist.end(circuit::Cell()); ++cluster)
+	{
+		double x = 0.0, y = 0.0, fixedX = 0.0, fixedY = 0.0;
+		std::size_t members = 0, fixed = 0;
+		for(auto const & cell : clustering.members(*cluster))
+		{
+			auto location = placement.cellLocation(cell);
+			if(placement.isFixed(cell))
+			{
+				fixedX += units::unit_cast<double>(location.x());
+				fixedY += units::unit_cast<double>(location.y());
+				++fixed;
+			}
+			x += units::unit_cast<double>(location.x());
+			y += units::unit_cast<double>(location.y());
+			++members;
+		}
+		if(fixed != 0)
+		{
+			clusters.placeCell(*cluster, util::LocationDbu(fixedX / fixed, fixedY / fixed));
+		}
+		else if(members != 0)
+		{
+			clusters.placeCell(*cluster, util::LocationDbu(x / members, y / members));
+		}
+		clusters.fixLocation(*cluster, fixed != 0);
+	}
+}
+
+void placeMembers(const circuit::Clustering & clustering, const Placement & clusters, Placement & placement)
+{
+	const auto & netlist = clustering.netlist();
+	for(auto cluster = netlist.begin(circuit::Cell()); cluster != netlist.end(circuit::Cell()); ++cluster)
+	{
+		auto location = clusters.cellLocation(*cluster);
+		for(auto const & cell : clustering.members(*cluster))
+		{
+			if(!placement.isFixed(cell))
+			{
+				placement.placeCell(cell, location);
+			}
+		}
+	}
+}
+
+} // namespace placement
+} // namespace ophidian
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_PLACEMENT_CLUSTERING_H
+#define OPHIDIAN_PLACEMENT_CLUSTERING_H
+
+#include <ophidian/circuit/Clustering.h>
+#include <ophidian/placement/Placement.h>
+
+namespace ophidian
+{
+namespace placement
+{
+
+//! Place the clusters
+/*!
+   \brief Places each cluster at the mean location of its Cells, restricting a placement to the clustered Netlist. A cluster with fixed Cells is placed at the mean location of those and fixed.
+   \param clustering The Clustering.
+   \param placement The Placement of the original Netlist.
+   \param clusters The Placement of the clustered Netlist, clustering.netlist().
+ */
+void placeClusters(const circuit::Clustering & clustering, const Placement & placement, Placement & clusters);
+
+//! Place the members of the clusters
+/*!
+   \brief Places every movable Cell at the location of its cluster, projecting a placement of the clustered Netlist back to the original one. Fixed Cells keep their locations.
+   \param clustering The Clustering.
+   \param clusters The Placement of the clustered Netlist, clustering.netlist().
+   \param placement The Placement of the original Netlist.
+ */
+void placeMembers(const circuit::Clustering & clustering, const Placement & clusters, Placement & placement);
+
+} // namespace placement
+} // namespace ophidian
+
+#endif // OPHIDIAN_PLACEMENT_CLUSTERING_H
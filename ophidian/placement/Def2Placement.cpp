@@ -24,11 +24,19 @@ namespace placement
 {
 
 void def2placement(const parser::Def & def, placement::Placement & placement, circuit::Netlist & netlist){
+	std::vector<std::string> cellNames;
+	cellNames.reserve(def.components().size());
+	for(auto & component : def.components())
+		cellNames.push_back(component.name);
+	auto cells = netlist.add(circuit::Cell(), cellNames);
+
+	auto cell = cells.begin();
 	for(auto & component : def.components())
 	{
 		util::LocationDbu cellPosition(component.position.x, component.position.y);
-		auto cell = netlist.add(circuit::Cell(), component.name);
-		placement.placeCell(cell, cellPosition);
+		placement.placeCell(*cell, cellPosition);
+		placement.fixLocation(*cell, component.fixed);
+		++cell;
 	}
 }
 
@@ -24,9 +24,26 @@ namespace placement
 {
 
 void lef2Library(const parser::Lef & lef, Library & library, standard_cell::StandardCells & stdCells){
+	std::vector<std::string> cellNames;
+	std::vector<std::string> pinNames;
+	std::vector<standard_cell::PinDirection> pinDirections;
+	cellNames.reserve(lef.macros().size());
+	for(auto & macro : lef.macros())
+	{
+		cellNames.push_back(macro.name);
+		for(auto & pin : macro.pins)
+		{
+			pinNames.push_back(macro.name+":"+pin.name);
+			pinDirections.push_back(standard_cell::PinDirection(pin.direction));
+		}
+	}
+	auto cells = stdCells.add(standard_cell::Cell(), cellNames);
+	auto pins = stdCells.add(standard_cell::Pin(), pinNames, pinDirections);
+
+	auto stdCell = cells.begin();
+	auto stdPin = pins.begin();
 	for(auto & macro : lef.macros())
 	{
-		auto stdCell = stdCells.add(standard_cell::Cell(), macro.name);
 		auto layer2RectsM1 = macro.obses.layer2rects.find("metal1");
 		if(layer2RectsM1 != macro.obses.layer2rects.end())
 		{
@@ -37,23 +54,24 @@ void lef2Library(const parser::Lef & lef, Library & library, standard_cell::Stan
 				ophidian::geometry::Point pmax = {units::unit_cast<double>(rect.secondPoint.x())*lef.databaseUnits(), units::unit_cast<double>(rect.secondPoint.y())*lef.databaseUnits()};
 				geometry.push_back(ophidian::geometry::Box(pmin, pmax));
 			}
-			library.geometry(stdCell, geometry);
+			library.geometry(*stdCell, geometry);
 		}
 		else {
 			ophidian::geometry::Point pmin = {macro.origin.x*lef.databaseUnits(), macro.origin.y*lef.databaseUnits()};
 			ophidian::geometry::Point pmax = {macro.size.x*lef.databaseUnits(), macro.size.y*lef.databaseUnits()};
-			library.geometry(stdCell, geometry::MultiBox({ophidian::geometry::Box(pmin, pmax)}));
+			library.geometry(*stdCell, geometry::MultiBox({ophidian::geometry::Box(pmin, pmax)}));
 		}
 		util::DbuConverter dbuConverter(lef.databaseUnits());
 
 		for(auto pin : macro.pins)
 		{
-			auto stdPin = stdCells.add(standard_cell::Pin(), macro.name+":"+pin.name, standard_cell::PinDirection(pin.direction));
-			stdCells.add(stdCell, stdPin);
+			stdCells.add(*stdCell, *stdPin);
 			for(auto port : pin.ports)
 				for(auto rect : port.rects)
-					library.pinOffset(stdPin, util::LocationDbu(0.5*(dbuConverter.convert(rect.firstPoint.x())+dbuConverter.convert(rect.secondPoint.x())), 0.5*(dbuConverter.convert(rect.firstPoint.y())+dbuConverter.convert(rect.secondPoint.y()))));
+					library.pinOffset(*stdPin, util::LocationDbu(0.5*(dbuConverter.convert(rect.firstPoint.x())+dbuConverter.convert(rect.secondPoint.x())), 0.5*(dbuConverter.convert(rect.firstPoint.y())+dbuConverter.convert(rect.secondPoint.y()))));
+			++stdPin;
 		}
+		++stdCell;
 	}
 }
 } // namespace placement
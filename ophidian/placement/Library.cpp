@@ -18,6 +18,8 @@
 
 #include "Library.h"
 
+#include <iterator>
+
 namespace ophidian
 {
 namespace placement
@@ -39,5 +41,18 @@ void Library::pinOffset(const standard_cell::Pin &pin, const util::LocationDbu &
 	mPinOffsets[pin] = offset;
 }
 
+util::MemoryUsage Library::memoryUsage() const
+{
+	util::MemoryUsage usage("Library");
+	auto geometries = mGeometries.memoryUsage();
+	for(auto const & boxes : mGeometries)
+	{
+		geometries.bytes += std::distance(boxes.begin(), boxes.end()) * sizeof(geometry::Box);
+	}
+	usage.add("geometries", geometries);
+	usage.add("pinOffsets", mPinOffsets.memoryUsage());
+	return usage;
+}
+
 } // namespace placement
 } // namespace ophidian
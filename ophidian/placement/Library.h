@@ -74,6 +74,12 @@ public:
 	 */
 	void pinOffset(const standard_cell::Pin & pin, const util::LocationDbu & offset);
 
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by the cell geometries, including their boxes, and the pin offsets.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
 private:
 	entity_system::Property<standard_cell::Cell, geometry::MultiBox> mGeometries;
 	entity_system::Property<standard_cell::Pin, util::LocationDbu> mPinOffsets;
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "Partitioning.h"
+
+namespace ophidian
+{
+namespace placement
+{
+
+std::vector<double> cellAreas(const circuit::Hypergraph & hypergraph, const Library & library, const circuit::LibraryMapping & mapping, const entity_system::ParallelOptions & options)
+{
+	std::vector<double> areas(hypergraph.size(circuit::Cell()), 0.0);
+	entity_system::parallel_for_range(areas.size(), [&](std::size_t first, std::size_t last) {
+		for(auto cell = first; cell < last; ++cell)
+		{
+			auto stdCell = mapping.cellStdCell(hypergraph.cell(cell));
+			if(stdCell == standard_cell::Cell())
+			{
+				continue;
+			}
+			for(auto const & box : library.geometry(stdCell))
+			{
+				areas[cell] += boost::geometry::area(box);
+			}
+		}
+	}, options);
+	return areas;
+}
+
+circuit::Partition partition(const circuit::Hypergraph & hypergraph, const Library & library, const circuit::LibraryMapping & mapping, const circuit::PartitionOptions & options)
+{
+	return circuit::partition(hypergraph, cellAreas(hypergraph, library, mapping, options.parallel), options);
+}
+
+} // namespace placement
+} // namespace ophidian
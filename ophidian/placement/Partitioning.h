@@ -0,0 +1,56 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_PLACEMENT_PARTITIONING_H
+#define OPHIDIAN_PLACEMENT_PARTITIONING_H
+
+#include <vector>
+#include <ophidian/circuit/LibraryMapping.h>
+#include <ophidian/circuit/Partitioning.h>
+#include <ophidian/placement/Library.h>
+
+namespace ophidian
+{
+namespace placement
+{
+
+//! Cell areas
+/*!
+   \brief Computes the area of each Cell of \p hypergraph, as the total area of the boxes of its standard cell.
+   \param hypergraph The Hypergraph of the Netlist.
+   \param library The placement Library with the geometry of the standard cells.
+   \param mapping The standard cell of each Cell. Cells without one get area 0.
+   \param options The grain size and the number of threads.
+   \return The areas, indexed like the Cells of \p hypergraph, to be used as partitioning weights.
+ */
+std::vector<double> cellAreas(const circuit::Hypergraph & hypergraph, const Library & library, const circuit::LibraryMapping & mapping, const entity_system::ParallelOptions & options = entity_system::ParallelOptions());
+
+//! Area-balanced partitioning
+/*!
+   \brief Partitions the Cells of \p hypergraph with circuit::partition(), balancing the area of the parts.
+   \param hypergraph The Hypergraph of the Netlist.
+   \param library The placement Library with the geometry of the standard cells.
+   \param mapping The standard cell of each Cell.
+   \param options The number of parts, the allowed imbalance and the tuning parameters.
+ */
+circuit::Partition partition(const circuit::Hypergraph & hypergraph, const Library & library, const circuit::LibraryMapping & mapping, const circuit::PartitionOptions & options = circuit::PartitionOptions());
+
+} // namespace placement
+} // namespace ophidian
+
+#endif // OPHIDIAN_PLACEMENT_PARTITIONING_H
@@ -24,10 +24,14 @@ namespace placement
 {
 
 Placement::Placement(const circuit::Netlist &netlist): 
-    mCellLocations(netlist.makeProperty<util::LocationDbu>(circuit::Cell())),
+    mCellLocations(netlist.makeSoAProperty<util::LocationDbu>(circuit::Cell())),
+    mCellChanges(netlist.makeChangeTracker(circuit::Cell())),
+    mCellFixed(netlist.makePackedProperty<bool>(circuit::Cell())),
     mInputLocations(netlist.makeProperty<util::LocationDbu>(circuit::Input())),
     mOutputLocations(netlist.makeProperty<util::LocationDbu>(circuit::Output()))
-    { }
+{
+    mCellLocations.trackChanges(&mCellChanges);
+}
 
 Placement::~Placement()
 {
@@ -36,12 +40,17 @@ Placement::~Placement()
 
 void Placement::placeCell(const circuit::Cell & cell, const util::LocationDbu & location)
 {
-    mCellLocations[cell] = location;
+    mCellLocations.set(cell, location);
+}
+
+void Placement::fixLocation(const circuit::Cell & cell, bool fixed)
+{
+    mCellFixed[cell] = fixed;
 }
 
 void Placement::placeInputPad(const circuit::Input &input, const util::LocationDbu &location)
 {
-    mInputLocations[input] = location;
+    mInputLocations.set(input, location);
 }
 
 util::LocationDbu Placement::inputPadLocation(const circuit::Input &input) const
@@ -51,7 +60,7 @@ util::LocationDbu Placement::inputPadLocation(const circuit::Input &input) const
 
 void Placement::placeOutputPad(const circuit::Output &output, const util::LocationDbu &location)
 {
-    mOutputLocations[output] = location;
+    mOutputLocations.set(output, location);
 }
 
 util::LocationDbu Placement::outputPadLocation(const circuit::Output &output) const
@@ -59,6 +68,38 @@ util::LocationDbu Placement::outputPadLocation(const circuit::Output &output) co
     return mOutputLocations[output];
 }
 
+void Placement::checkpoint()
+{
+    mCellLocations.checkpoint();
+    mInputLocations.checkpoint();
+    mOutputLocations.checkpoint();
+}
+
+void Placement::rollback()
+{
+    mCellLocations.rollback();
+    mInputLocations.rollback();
+    mOutputLocations.rollback();
+}
+
+void Placement::commit()
+{
+    mCellLocations.commit();
+    mInputLocations.commit();
+    mOutputLocations.commit();
+}
+
+util::MemoryUsage Placement::memoryUsage() const
+{
+    util::MemoryUsage usage("Placement");
+    usage.add("cellLocations", mCellLocations.memoryUsage());
+    usage.add("cellChanges", mCellChanges.memoryUsage());
+    usage.add("cellFixed", mCellFixed.memoryUsage());
+    usage.add("inputLocations", mInputLocations.memoryUsage());
+    usage.add("outputLocations", mOutputLocations.memoryUsage());
+    return usage;
+}
+
 
 } //namespace placement
 
@@ -21,12 +21,41 @@
 
 #include <ophidian/entity_system/EntitySystem.h>
 #include <ophidian/entity_system/Property.h>
+#include <ophidian/entity_system/SoAProperty.h>
+#include <ophidian/entity_system/ChangeTracker.h>
 #include <ophidian/util/Range.h>
 #include <ophidian/util/Units.h>
 #include <ophidian/circuit/Netlist.h>
 
 namespace ophidian
 {
+namespace entity_system
+{
+
+//! LocationDbu fields
+/*!
+   Splits a LocationDbu into its x and y coordinates, in DBUs, so SoAProperty can store them in separate arrays.
+ */
+template <>
+struct SoAFields<util::LocationDbu>
+{
+	using Field = double;
+	static constexpr std::size_t fields = 2;
+	enum { X = 0, Y = 1 };
+
+	static Field get(const util::LocationDbu & location, std::size_t field)
+	{
+		return units::unit_cast<double>(field == X ? location.x() : location.y());
+	}
+
+	static util::LocationDbu make(const std::array<Field, fields> & coordinates)
+	{
+		return util::LocationDbu(coordinates[X], coordinates[Y]);
+	}
+};
+
+} //namespace entity_system
+
 namespace placement
 {
 
@@ -64,6 +93,49 @@ public:
         return mCellLocations[cell];
 	}
 
+	//! Cell locations
+	/*!
+	   \brief Returns the locations of all cells, stored as separate x and y arrays.
+	   \remarks data(SoAFields<LocationDbu>::X) and data(SoAFields<LocationDbu>::Y) are 64-byte aligned arrays of DBUs, indexed like the netlist's Cells. They suit vectorized wirelength and density kernels.
+	 */
+	const entity_system::SoAProperty<circuit::Cell, util::LocationDbu> & cellLocations() const {
+		return mCellLocations;
+	}
+
+	//! Cell location changes
+	/*!
+	   \brief Returns the tracker of the cells whose location changed. Incremental consumers (e.g., net bounding boxes or density bins) subscribe to it and drain the moved cells on each iteration.
+	   \return The ChangeTracker of the cell locations.
+	 */
+	entity_system::ChangeTracker<circuit::Cell> & cellChanges() {
+		return mCellChanges;
+	}
+
+	//! Fixes or releases a cell
+	/*!
+	   \brief Marks a cell as fixed, i.e., its location must not be changed by placement algorithms, or as movable.
+	   \param cell Cell to be fixed or released.
+	   \param fixed true for fixed, false for movable.
+	 */
+	void fixLocation(const circuit::Cell & cell, bool fixed = true);
+
+	//! Fixed cell
+	/*!
+	   \param cell Cell entity.
+	   \return true if \p cell is fixed, false if it is movable.
+	 */
+	bool isFixed(const circuit::Cell & cell) const {
+		return mCellFixed[cell];
+	}
+
+	//! Fixed flags
+	/*!
+	   \brief Returns the fixed flags of all cells, one bit per cell. Use count(false) to count the movable cells and forEach(false, f) to visit them.
+	 */
+	const entity_system::BitProperty<circuit::Cell> & fixedCells() const {
+		return mCellFixed;
+	}
+
 void placeInputPad(const circuit::Input & input, const util::LocationDbu & location);
 
     util::LocationDbu inputPadLocation(const circuit::Input & input) const;
@@ -72,8 +144,37 @@ void placeInputPad(const circuit::Input & input, const util::LocationDbu & locat
 
     util::LocationDbu outputPadLocation(const circuit::Output & output) const;
 
+	//! Opens a checkpoint
+	/*!
+	   \brief Starts recording the changes to cell and pad locations, so a tentative move can be reverted by rollback(). Checkpoints nest.
+	 */
+	void checkpoint();
+
+	//! Reverts to the last checkpoint
+	/*!
+	   \brief Restores the locations changed since the last checkpoint, in O(changes), and closes it.
+	 */
+	void rollback();
+
+	//! Commits the last checkpoint
+	/*!
+	   \brief Keeps the locations changed since the last checkpoint and closes it.
+	 */
+	void commit();
+
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by the Placement: cell and pad locations and the cell change tracker.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
 private:
-    entity_system::Property<circuit::Cell, util::LocationDbu> mCellLocations;
+    Placement(const Placement & placement) = delete;
+    Placement & operator=(const Placement & placement) = delete;
+
+    entity_system::SoAProperty<circuit::Cell, util::LocationDbu> mCellLocations;
+    entity_system::ChangeTracker<circuit::Cell> mCellChanges;
+    entity_system::BitProperty<circuit::Cell> mCellFixed;
     entity_system::Property<circuit::Input, util::LocationDbu> mInputLocations;
     entity_system::Property<circuit::Output, util::LocationDbu> mOutputLocations;
 };
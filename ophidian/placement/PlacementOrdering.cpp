@@ -0,0 +1,84 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#include "PlacementOrdering.h"
+#include <algorithm>
+#include <numeric>
+
+namespace ophidian
+{
+namespace placement
+{
+namespace
+{
+//! Distance of the grid point (x, y) along a Hilbert curve covering a 2^16 x 2^16 grid
+uint64_t hilbertDistance(uint32_t x, uint32_t y)
+{
+	uint64_t distance = 0;
+	for(uint32_t side = 1u << 15; side > 0; side >>= 1)
+	{
+		uint32_t rx = (x & side) ? 1 : 0;
+		uint32_t ry = (y & side) ? 1 : 0;
+		distance += static_cast<uint64_t>(side) * side * ((3 * rx) ^ ry);
+		if(ry == 0)
+		{
+			if(rx == 1)
+			{
+				x = side - 1 - (x & (side - 1));
+				y = side - 1 - (y & (side - 1));
+			}
+			std::swap(x, y);
+		}
+	}
+	return distance;
+}
+} // namespace
+
+std::vector<uint32_t> hilbertOrder(const Placement & placement)
+{
+	using Fields = entity_system::SoAFields<util::LocationDbu>;
+	auto const & locations = placement.cellLocations();
+	const double * xs = locations.data(Fields::X);
+	const double * ys = locations.data(Fields::Y);
+	const std::size_t size = locations.size();
+
+	std::vector<uint32_t> order(size);
+	std::iota(order.begin(), order.end(), 0);
+	if(size == 0)
+	{
+		return order;
+	}
+	auto xBounds = std::minmax_element(xs, xs + size);
+	auto yBounds = std::minmax_element(ys, ys + size);
+	const double scale = 65535.0 / std::max({*xBounds.second - *xBounds.first, *yBounds.second - *yBounds.first, 1.0});
+
+	std::vector<uint64_t> keys(size);
+	for(std::size_t index = 0; index < size; ++index)
+	{
+		auto x = static_cast<uint32_t>((xs[index] - *xBounds.first) * scale);
+		auto y = static_cast<uint32_t>((ys[index] - *yBounds.first) * scale);
+		keys[index] = hilbertDistance(x, y);
+	}
+	std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) {
+		return keys[a] < keys[b];
+	});
+	return order;
+}
+
+} // namespace placement
+} // namespace ophidian
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_PLACEMENT_PLACEMENTORDERING_H
+#define OPHIDIAN_PLACEMENT_PLACEMENTORDERING_H
+
+#include <cstdint>
+#include <vector>
+#include <ophidian/placement/Placement.h>
+
+namespace ophidian
+{
+namespace placement
+{
+
+//! Hilbert Cell order
+/*!
+   \brief Orders the Cells along a Hilbert curve over their locations, so Cells placed near each other end up near each other in every Cell Property.
+   \param placement The placement of the Cells.
+   \return A permutation of the Cell positions, to be given to Netlist::permute(Cell(), order).
+ */
+std::vector<uint32_t> hilbertOrder(const Placement & placement);
+
+} // namespace placement
+} // namespace ophidian
+
+#endif // OPHIDIAN_PLACEMENT_PLACEMENTORDERING_H
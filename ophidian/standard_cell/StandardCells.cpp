@@ -24,14 +24,19 @@ namespace standard_cell
 {
 
 
-StandardCells::StandardCells() :
-	mCellNames(mCells), mPinNames(mPins), mPinDirections(mPins),
+StandardCells::StandardCells(util::MemoryResource* resource, util::StringPool* names) :
+	mOwnedNamePool(names ? nullptr : std::make_shared<util::StringPool>()),
+	mNamePool(names ? names : mOwnedNamePool.get()),
+	mCells(resource), mCellNames(mCells, *mNamePool),
+	mPins(resource), mPinNames(mPins, *mNamePool), mPinDirections(mPins),
 	mCellPins(mCells, mPins)
 {
 
 }
 
 StandardCells::StandardCells(const StandardCells && stdCell) :
+	mOwnedNamePool(stdCell.mOwnedNamePool),
+	mNamePool(stdCell.mNamePool),
 	mCells(std::move(stdCell.mCells)),
 	mPins(std::move(stdCell.mPins)),
 	mCellNames(std::move(stdCell.mCellNames)),
@@ -46,29 +51,32 @@ StandardCells::~StandardCells() = default;
 
 //--------------------------- Cells -------------------------------//
 
-Cell StandardCells::add(Cell, const std::string &name)
+Cell StandardCells::add(Cell, util::StringView name)
 {
-	if(mName2Cell.find(name) == mName2Cell.end())
+	auto symbol = mCellNames.intern(name);
+	auto cell = mCellNames.entity(symbol);
+	if(cell == Cell())
 	{
-		auto cell = mCells.add();
-		mCellNames[cell] = name;
-		mName2Cell[name] = cell;
-		return cell;
-	}
-	else {
-		return mName2Cell[name];
+		cell = mCells.add();
+		mCellNames.assign(cell, symbol);
 	}
+	return cell;
+}
+
+std::vector<Cell> StandardCells::add(Cell, const std::vector<std::string> &names)
+{
+	return mCellNames.add(mCells, names);
 }
 
 void StandardCells::erase(const Cell & cell)
 {
-	mName2Cell.erase(name(cell));
 	mCells.erase(cell);
 }
 
 void StandardCells::reserve(Cell, uint32_t size)
 {
 	mCells.reserve(size);
+	mCellNames.reserve(size);
 }
 
 uint32_t StandardCells::size(Cell) const
@@ -81,14 +89,14 @@ uint32_t StandardCells::capacity(Cell) const
 	return mCells.capacity();
 }
 
-Cell StandardCells::find(Cell, std::string cellName)
+Cell StandardCells::find(Cell, util::StringView cellName) const
 {
-	return mName2Cell[cellName];
+	return mCellNames.find(cellName);
 }
 
 std::string StandardCells::name(const Cell & cell) const
 {
-	return mCellNames[cell];
+	return mCellNames.name(cell);
 }
 
 entity_system::Association<Cell, Pin>::Parts StandardCells::pins(const Cell &cell) const
@@ -103,30 +111,43 @@ ophidian::util::Range<StandardCells::CellsIterator> StandardCells::range(Cell) c
 
 //--------------------------- Pins -------------------------------//
 
-Pin StandardCells::add(Pin, const std::string &name, PinDirection direction)
+Pin StandardCells::add(Pin, util::StringView name, PinDirection direction)
 {
-	if(mName2Pin.find(name) == mName2Pin.end())
+	auto symbol = mPinNames.intern(name);
+	auto pin = mPinNames.entity(symbol);
+	if(pin == Pin())
 	{
-        auto pin = mPins.add();
-		mPinNames[pin] = name;
+		pin = mPins.add();
+		mPinNames.assign(pin, symbol);
 		mPinDirections[pin] = direction;
-		mName2Pin[name] = pin;
-		return pin;
 	}
-	else {
-		return mName2Pin[name];
+	return pin;
+}
+
+std::vector<Pin> StandardCells::add(Pin, const std::vector<std::string> &names, const std::vector<PinDirection> &directions)
+{
+	auto existing = mPins.size();
+	auto pins = mPinNames.add(mPins, names);
+	// backwards, so the first occurrence of a repeated name sets the direction
+	for(auto i = pins.size(); i > 0; --i)
+	{
+		if(mPins.id(pins[i - 1]) >= existing)
+		{
+			mPinDirections[pins[i - 1]] = directions[i - 1];
+		}
 	}
+	return pins;
 }
 
 void StandardCells::erase(const Pin & pin)
 {
-	mName2Pin.erase(name(pin));
 	mPins.erase(pin);
 }
 
 void StandardCells::reserve(Pin, uint32_t size)
 {
 	mPins.reserve(size);
+	mPinNames.reserve(size);
 }
 
 uint32_t StandardCells::size(Pin) const
@@ -134,22 +155,27 @@ uint32_t StandardCells::size(Pin) const
 	return mPins.size();
 }
 
+uint32_t StandardCells::size(Pin, PinDirection direction) const
+{
+	return mPinDirections.count(direction);
+}
+
 uint32_t StandardCells::capacity(Pin) const
 {
 	return mPins.capacity();
 }
 
-Pin StandardCells::find(Pin, std::string pinName)
+Pin StandardCells::find(Pin, util::StringView pinName) const
 {
-	return mName2Pin[pinName];
+	return mPinNames.find(pinName);
 }
 
 std::string StandardCells::name(const Pin & pin) const
 {
-	return mPinNames[pin];
+	return mPinNames.name(pin);
 }
 
-PinDirection StandardCells::direction(const Pin & pin)
+PinDirection StandardCells::direction(const Pin & pin) const
 {
 	return mPinDirections[pin];
 }
@@ -177,6 +203,27 @@ void StandardCells::add(const Cell& cell, const Pin& pin)
 	mCellPins.addAssociation(cell, pin);
 }
 
+void StandardCells::freezeNames()
+{
+	mNamePool->freeze();
+}
+
+util::MemoryUsage StandardCells::memoryUsage() const
+{
+	util::MemoryUsage usage("StandardCells");
+	usage.add("cells", mCells.memoryUsage());
+	usage.add("cellNames", mCellNames.memoryUsage());
+	usage.add("pins", mPins.memoryUsage());
+	usage.add("pinNames", mPinNames.memoryUsage());
+	usage.add("pinDirections", mPinDirections.memoryUsage());
+	usage.add("cellPins", mCellPins.memoryUsage());
+	if(mOwnedNamePool)
+	{
+		usage.add("namePool", mOwnedNamePool->memoryUsage());
+	}
+	return usage;
+}
+
 } //namespace ophidian
 
 } //namespace standard_cell
@@ -20,10 +20,11 @@
 #define OPHIDIAN_STANDARD_CELL_STANDARD_CELLS_H
 
 #include <memory>
-#include <unordered_map>
 #include <ophidian/entity_system/EntitySystem.h>
 #include <ophidian/entity_system/Property.h>
+#include <ophidian/entity_system/PackedProperty.h>
 #include <ophidian/entity_system/Composition.h>
+#include <ophidian/entity_system/NameIndex.h>
 #include <ophidian/util/Range.h>
 
 namespace ophidian
@@ -57,8 +58,10 @@ public:
 	//! StandardCell Constructor
 	/*!
 	   \brief Constructs an empty system with no Cells and Pins.
+	   \param resource The MemoryResource for the EntitySystems and Properties. It must outlive the StandardCells.
+	   \param names The StringPool where the names of Cells and Pins are interned. It must outlive the StandardCells. If null, the StandardCells own their own pool.
 	 */
-	StandardCells();
+	explicit StandardCells(util::MemoryResource* resource = util::defaultResource(), util::StringPool* names = nullptr);
 
 	//! StandardCell Move Constructor
 	/*!
@@ -76,11 +79,19 @@ public:
 
 	//! Add Cell
 	/*!
-	   \brief Adds a cell instance. A cell has a name associated to it. If the cell already exist then just return the existing cell.
+	   \brief Adds a cell instance. A cell has a name associated to it. If the cell already exist then just return the existing cell. The name is hashed and probed once either way.
 	   \param name Name of the cell, used to identify it.
 	   \return A handler for the created/existing Cell.
 	 */
-	Cell add(Cell, const std::string & name);
+	Cell add(Cell, util::StringView name);
+
+	//! Add Cells
+	/*!
+	   \brief Adds a cell instance for each name that doesn't exist yet, notifying the Cell's Properties only once.
+	   \param names Names of the cells.
+	   \return The handlers for the created/existing Cells, in the same order as \p names.
+	 */
+	std::vector<Cell> add(Cell, const std::vector<std::string> & names);
 
 	//! Erase Cell
 	/*!
@@ -111,11 +122,11 @@ public:
 
 	//! Find a cell
 	/*!
-	   \brief Using the mapping, return a cell handler by cell's name.
+	   \brief Using the mapping, return a cell handler by cell's name. Does not allocate, and does not add missing names.
 	   \param The cell name.
-	   \return Return a cell handler by cell's name.
+	   \return Return a cell handler by cell's name, or Cell() if there is no such cell.
 	 */
-	Cell find(Cell, std::string cellName);
+	Cell find(Cell, util::StringView cellName) const;
 
 	//! Cells iterator
 	/*!
@@ -155,11 +166,20 @@ public:
 
 	//! Add Pin
 	/*!
-	   \brief Adds a pin instance. A pin has a name and a direction associated to it.  If the pin already exist then just return the existing pin.
+	   \brief Adds a pin instance. A pin has a name and a direction associated to it.  If the pin already exist then just return the existing pin. The name is hashed and probed once either way.
 	   \param name Name of the pin, used to identify it.
 	   \return A handler for the created/existing pin.
 	 */
-	Pin add(Pin, const std::string & name, PinDirection direction);
+	Pin add(Pin, util::StringView name, PinDirection direction);
+
+	//! Add Pins
+	/*!
+	   \brief Adds a pin instance for each name that doesn't exist yet, notifying the Pin's Properties only once.
+	   \param names Names of the pins.
+	   \param directions Directions of the pins, in the same order as \p names.
+	   \return The handlers for the created/existing Pins, in the same order as \p names.
+	 */
+	std::vector<Pin> add(Pin, const std::vector<std::string> & names, const std::vector<PinDirection> & directions);
 
 	//! Erase Pin
 	/*!
@@ -182,6 +202,14 @@ public:
 	 */
 	uint32_t size(Pin) const;
 
+	//! Number of Pins with a direction
+	/*!
+	   \brief Counts the pins with a given direction, testing 32 pins per word.
+	   \param direction The direction to count.
+	   \return The number of pins whose direction is \p direction.
+	 */
+	uint32_t size(Pin, PinDirection direction) const;
+
 	//! Capacity of the Pin's System
 	/*!
 	   \return The capacity of the Pin EntitySystem.
@@ -190,11 +218,11 @@ public:
 
 	//! Find a pin
 	/*!
-	   \brief Using the mapping, return a pin handler by pin's name.
+	   \brief Using the mapping, return a pin handler by pin's name. Does not allocate, and does not add missing names.
 	   \param The pin name.
-	   \return Return a pin handler by pin's name.
+	   \return Return a pin handler by pin's name, or Pin() if there is no such pin.
 	 */
-	Pin find(Pin, std::string pinName);
+	Pin find(Pin, util::StringView pinName) const;
 
 	//! Pin name getter
 	/*!
@@ -210,7 +238,17 @@ public:
 	   \param pin Pin entity to get the direction.
 	   \return Direction of the pin
 	 */
-	PinDirection direction(const Pin & pin);
+	PinDirection direction(const Pin & pin) const;
+
+	//! Pin directions
+	/*!
+	   \brief Returns the directions of all pins, packed in 2 bits per pin. Use forEach() to visit the pins with a given direction, e.g., every output pin.
+	   \return The Pin => PinDirection map.
+	 */
+	const entity_system::PackedProperty<Pin, PinDirection, 2> & directions() const
+	{
+		return mPinDirections;
+	}
 
 	//! Pin owner getter
 	/*!
@@ -248,22 +286,34 @@ public:
 	//Maybe rename to create_association or associate...
 	void add(const Cell& cell, const Pin& pin);
 
+	//! Freeze names
+	/*!
+	   \brief Replaces the hash table of the StringPool of the names by a perfect hash with its slots at 80% load (see util::StringPool::freeze()), which uses less memory and finds a name with a single probe. Names can still be added afterwards.
+	 */
+	void freezeNames();
+
+	//! Memory usage
+	/*!
+	   \brief Reports the memory held by the Standard Cells: EntitySystems, Properties, the Cell-Pin composition, the name indices and the StringPool, unless it was given to the constructor.
+	 */
+	util::MemoryUsage memoryUsage() const;
+
 private:
+	//names of cells and pins
+	std::shared_ptr<util::StringPool> mOwnedNamePool;
+	util::StringPool* mNamePool;
+
 	//cells entity system and properties
 	entity_system::EntitySystem<Cell> mCells;
-	entity_system::Property<Cell, std::string> mCellNames;
+	entity_system::NameIndex<Cell> mCellNames;
 
 	//pins entity system and properties
 	entity_system::EntitySystem<Pin> mPins;
-	entity_system::Property<Pin, std::string> mPinNames;
-	entity_system::Property<Pin, PinDirection> mPinDirections;
+	entity_system::NameIndex<Pin> mPinNames;
+	entity_system::PackedProperty<Pin, PinDirection, 2> mPinDirections;
 
 	//composition and aggregation relations
 	entity_system::Composition<Cell, Pin> mCellPins;
-
-	//std_cell and pin mapping
-	std::unordered_map<std::string, Cell> mName2Cell;
-	std::unordered_map<std::string, Pin> mName2Pin;
 };
 
 } //namespace ophidian
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_UTIL_ALIGNEDALLOCATOR_H
+#define OPHIDIAN_UTIL_ALIGNEDALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <ophidian/util/MemoryResource.h>
+
+namespace ophidian
+{
+namespace util
+{
+
+//! Aligned Allocator
+/*!
+   A std::allocator replacement that returns memory aligned to \p Alignment bytes, such as the 64 bytes of a cache line or of an AVX-512 register.
+   Like PolymorphicAllocator, it draws the memory from a MemoryResource.
+ */
+template <class T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+	static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+	static_assert(Alignment >= alignof(void*), "Alignment must fit a pointer");
+public:
+	using value_type = T;
+
+	template <class U>
+	struct rebind
+	{
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	AlignedAllocator(MemoryResource* resource = defaultResource()) noexcept :
+		mResource(resource)
+	{
+
+	}
+
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>& other) noexcept :
+		mResource(other.resource())
+	{
+
+	}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(mResource->allocate(n * sizeof(T), alignment()));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept
+	{
+		mResource->deallocate(p, n * sizeof(T), alignment());
+	}
+
+	AlignedAllocator select_on_container_copy_construction() const
+	{
+		return *this;
+	}
+
+	MemoryResource* resource() const noexcept
+	{
+		return mResource;
+	}
+
+	template <class U>
+	bool operator==(const AlignedAllocator<U, Alignment>& other) const noexcept
+	{
+		return mResource == other.resource();
+	}
+
+	template <class U>
+	bool operator!=(const AlignedAllocator<U, Alignment>& other) const noexcept
+	{
+		return mResource != other.resource();
+	}
+
+private:
+	static constexpr std::size_t alignment()
+	{
+		return std::max(Alignment, alignof(T));
+	}
+
+	MemoryResource* mResource;
+};
+
+} // namespace util
+} // namespace ophidian
+
+#endif // OPHIDIAN_UTIL_ALIGNEDALLOCATOR_H
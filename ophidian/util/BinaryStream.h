@@ -0,0 +1,267 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_UTIL_BINARYSTREAM_H
+#define OPHIDIAN_UTIL_BINARYSTREAM_H
+
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ophidian
+{
+namespace util
+{
+
+class InvalidBinaryFormat : public std::exception
+{
+public:
+	const char* what() const noexcept override {
+		return "The binary stream is truncated or does not hold the expected block";
+	}
+};
+
+class UnsupportedBinaryVersion : public std::exception
+{
+public:
+	const char* what() const noexcept override {
+		return "The binary stream was written by a newer format version";
+	}
+};
+
+class BinaryChecksumMismatch : public std::exception
+{
+public:
+	const char* what() const noexcept override {
+		return "The checksum of a binary block does not match its contents";
+	}
+};
+
+//! Binary block format
+/*!
+   Every block is a 32-byte header followed by the payload and a 64-bit FNV-1a checksum of the payload:
+   magic "OPHB", format version (16 bits), tag (16 bits), element size (32 bits, 0 for strings), reserved (32 bits), element count (64 bits) and payload bytes (64 bits).
+   Arrays of trivially copyable values are dumped as they are in memory; arrays of strings are encoded as their lengths (64 bits each) followed by their characters.
+   Blocks are written in the byte order of the host.
+ */
+struct BinaryFormat
+{
+	static constexpr std::uint32_t kMagic = 0x4248504f;
+	static constexpr std::uint16_t kVersion = 1;
+
+	struct Header
+	{
+		std::uint32_t magic;
+		std::uint16_t version;
+		std::uint16_t tag;
+		std::uint32_t elementSize;
+		std::uint32_t reserved;
+		std::uint64_t count;
+		std::uint64_t bytes;
+	};
+
+	//! FNV-1a hash of \p bytes bytes, continuing from \p hash
+	static std::uint64_t checksum(const void* data, std::size_t bytes, std::uint64_t hash = 0xcbf29ce484222325ull)
+	{
+		auto byte = static_cast<const unsigned char*>(data);
+		for(std::size_t i = 0; i < bytes; ++i)
+		{
+			hash = (hash ^ byte[i]) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+};
+
+//! Binary Writer
+/*!
+   Writes arrays as checksummed, versioned blocks (see BinaryFormat). Each block carries a tag so the reader can check it loads blocks in the order they were written.
+ */
+class BinaryWriter
+{
+public:
+	explicit BinaryWriter(std::ostream& out) :
+		mOut(out)
+	{
+
+	}
+
+	//! Write an array of trivially copyable values
+	template <class T>
+	typename std::enable_if<std::is_trivially_copyable<T>::value>::type write(std::uint16_t tag, const T* data, std::size_t count)
+	{
+		writeHeader(tag, sizeof(T), count, count * sizeof(T));
+		writeBytes(data, count * sizeof(T));
+		writeChecksum(BinaryFormat::checksum(data, count * sizeof(T)));
+	}
+
+	//! Write an array of strings
+	void write(std::uint16_t tag, const std::string* data, std::size_t count)
+	{
+		std::vector<std::uint64_t> lengths(count);
+		std::uint64_t characters = 0;
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			lengths[i] = data[i].size();
+			characters += lengths[i];
+		}
+		writeHeader(tag, 0, count, count * sizeof(std::uint64_t) + characters);
+		writeBytes(lengths.data(), count * sizeof(std::uint64_t));
+		auto hash = BinaryFormat::checksum(lengths.data(), count * sizeof(std::uint64_t));
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			writeBytes(data[i].data(), data[i].size());
+			hash = BinaryFormat::checksum(data[i].data(), data[i].size(), hash);
+		}
+		writeChecksum(hash);
+	}
+
+	template <class T, class Allocator>
+	void write(std::uint16_t tag, const std::vector<T, Allocator>& values)
+	{
+		write(tag, values.data(), values.size());
+	}
+
+private:
+	void writeHeader(std::uint16_t tag, std::uint32_t elementSize, std::uint64_t count, std::uint64_t bytes)
+	{
+		BinaryFormat::Header header{BinaryFormat::kMagic, BinaryFormat::kVersion, tag, elementSize, 0, count, bytes};
+		writeBytes(&header, sizeof(header));
+	}
+	void writeChecksum(std::uint64_t hash)
+	{
+		writeBytes(&hash, sizeof(hash));
+	}
+	void writeBytes(const void* data, std::size_t bytes)
+	{
+		mOut.write(static_cast<const char*>(data), bytes);
+	}
+
+	std::ostream& mOut;
+};
+
+//! Binary Reader
+/*!
+   Reads the blocks written by BinaryWriter, checking their magic, version, tag, element size and checksum.
+   Throws InvalidBinaryFormat, UnsupportedBinaryVersion or BinaryChecksumMismatch; the destination array is unspecified after a throw.
+ */
+class BinaryReader
+{
+public:
+	explicit BinaryReader(std::istream& in) :
+		mIn(in)
+	{
+
+	}
+
+	//! Read an array of trivially copyable values
+	/*!
+	   \brief Reads the next block, which must have tag \p tag, into \p values, resizing it to the number of elements in the block.
+	 */
+	template <class T, class Allocator>
+	typename std::enable_if<std::is_trivially_copyable<T>::value>::type read(std::uint16_t tag, std::vector<T, Allocator>& values)
+	{
+		auto header = readHeader(tag, sizeof(T));
+		// the count is checked against the bytes first, so a corrupt count neither overflows nor allocates
+		if(header.count > header.bytes / sizeof(T) || header.bytes != header.count * sizeof(T))
+		{
+			throw InvalidBinaryFormat();
+		}
+		values.resize(header.count);
+		readBytes(values.data(), header.bytes);
+		checkChecksum(BinaryFormat::checksum(values.data(), header.bytes));
+	}
+
+	//! Read an array of strings
+	template <class Allocator>
+	void read(std::uint16_t tag, std::vector<std::string, Allocator>& values)
+	{
+		auto header = readHeader(tag, 0);
+		if(header.count > header.bytes / sizeof(std::uint64_t))
+		{
+			throw InvalidBinaryFormat();
+		}
+		std::vector<std::uint64_t> lengths(header.count);
+		readBytes(lengths.data(), header.count * sizeof(std::uint64_t));
+		auto hash = BinaryFormat::checksum(lengths.data(), header.count * sizeof(std::uint64_t));
+		std::uint64_t characters = header.bytes - header.count * sizeof(std::uint64_t);
+		values.resize(header.count);
+		for(std::size_t i = 0; i < header.count; ++i)
+		{
+			if(lengths[i] > characters)
+			{
+				throw InvalidBinaryFormat();
+			}
+			characters -= lengths[i];
+			values[i].resize(lengths[i]);
+			readBytes(&values[i][0], lengths[i]);
+			hash = BinaryFormat::checksum(values[i].data(), lengths[i], hash);
+		}
+		if(characters != 0)
+		{
+			throw InvalidBinaryFormat();
+		}
+		checkChecksum(hash);
+	}
+
+private:
+	BinaryFormat::Header readHeader(std::uint16_t tag, std::uint32_t elementSize)
+	{
+		BinaryFormat::Header header;
+		readBytes(&header, sizeof(header));
+		if(header.magic != BinaryFormat::kMagic)
+		{
+			throw InvalidBinaryFormat();
+		}
+		if(header.version > BinaryFormat::kVersion)
+		{
+			throw UnsupportedBinaryVersion();
+		}
+		if(header.tag != tag || header.elementSize != elementSize)
+		{
+			throw InvalidBinaryFormat();
+		}
+		return header;
+	}
+	void checkChecksum(std::uint64_t hash)
+	{
+		std::uint64_t stored;
+		readBytes(&stored, sizeof(stored));
+		if(stored != hash)
+		{
+			throw BinaryChecksumMismatch();
+		}
+	}
+	void readBytes(void* data, std::size_t bytes)
+	{
+		if(bytes != 0 && !mIn.read(static_cast<char*>(data), bytes))
+		{
+			throw InvalidBinaryFormat();
+		}
+	}
+
+	std::istream& mIn;
+};
+
+} // namespace util
+} // namespace ophidian
+
+#endif // OPHIDIAN_UTIL_BINARYSTREAM_H
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_UTIL_MEMORYRESOURCE_H
+#define OPHIDIAN_UTIL_MEMORYRESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace ophidian
+{
+namespace util
+{
+
+//! Memory Resource
+/*!
+   A polymorphic source of memory, in the spirit of C++17's std::pmr::memory_resource. EntitySystems and Properties allocate their storage through one.
+ */
+class MemoryResource
+{
+public:
+	virtual ~MemoryResource()
+	{
+
+	}
+
+	//! Allocate memory
+	/*!
+	   \param bytes The size of the block.
+	   \param alignment The alignment of the block, a power of two.
+	   \return A pointer to the block. Throws std::bad_alloc on failure.
+	 */
+	virtual void* allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+	//! Deallocate memory
+	/*!
+	   \param p A block returned by allocate(\p bytes, \p alignment).
+	 */
+	virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+//! Heap Resource
+/*!
+   Allocates every block from the global operator new.
+ */
+class HeapResource final : public MemoryResource
+{
+public:
+	void* allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		if(alignment <= alignof(std::max_align_t))
+		{
+			return ::operator new(bytes);
+		}
+		void* raw = ::operator new(bytes + alignment);
+		std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + alignment) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+		reinterpret_cast<void**>(aligned)[-1] = raw;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	void deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		if(alignment <= alignof(std::max_align_t))
+		{
+			::operator delete(p);
+			return;
+		}
+		::operator delete(reinterpret_cast<void**>(p)[-1]);
+	}
+};
+
+//! Default Resource
+/*!
+   \return The process-wide HeapResource, used when no MemoryResource is given.
+ */
+inline MemoryResource* defaultResource()
+{
+	static HeapResource resource;
+	return &resource;
+}
+
+//! Monotonic Arena
+/*!
+   Hands out memory from large chunks requested to an upstream MemoryResource, and never gives individual blocks back.
+   All chunks are released at once by release() or by the destructor, so tearing down every container allocated from the arena costs a handful of deallocations.
+   \remarks Containers that grow geometrically leave their old buffers behind, so reserve() before filling large containers. The arena is not thread safe.
+ */
+class MonotonicArena final : public MemoryResource
+{
+public:
+	//! Construct MonotonicArena
+	/*!
+	   \param upstream The MemoryResource that provides the chunks.
+	   \param chunkSize The size of the first chunk. Each following chunk doubles in size, up to 256 MiB.
+	 */
+	explicit MonotonicArena(MemoryResource* upstream = defaultResource(), std::size_t chunkSize = 1 << 20) :
+		mUpstream(upstream),
+		mNextChunkSize(chunkSize),
+		mCurrent(nullptr),
+		mRemaining(0),
+		mAllocated(0)
+	{
+
+	}
+
+	MonotonicArena(const MonotonicArena&) = delete;
+	MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+	~MonotonicArena() override
+	{
+		release();
+	}
+
+	void* allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(mCurrent) % alignment) % alignment;
+		if(mCurrent == nullptr || padding + bytes > mRemaining)
+		{
+			grow(bytes + alignment);
+			padding = (alignment - reinterpret_cast<std::uintptr_t>(mCurrent) % alignment) % alignment;
+		}
+		char* block = mCurrent + padding;
+		mCurrent = block + bytes;
+		mRemaining -= padding + bytes;
+		mAllocated += bytes;
+		return block;
+	}
+
+	void deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+	}
+
+	//! Release all memory
+	/*!
+	   \brief Gives every chunk back to the upstream resource. Blocks allocated before must not be used anymore.
+	 */
+	void release()
+	{
+		for(auto const & chunk : mChunks)
+		{
+			mUpstream->deallocate(chunk.first, chunk.second, alignof(std::max_align_t));
+		}
+		mChunks.clear();
+		mCurrent = nullptr;
+		mRemaining = 0;
+		mAllocated = 0;
+	}
+
+	//! Allocated bytes
+	/*!
+	   \return The number of bytes handed out since the last release, excluding padding.
+	 */
+	std::size_t allocatedBytes() const
+	{
+		return mAllocated;
+	}
+
+	//! Reserved bytes
+	/*!
+	   \return The number of bytes held from the upstream resource.
+	 */
+	std::size_t reservedBytes() const
+	{
+		std::size_t reserved = 0;
+		for(auto const & chunk : mChunks)
+		{
+			reserved += chunk.second;
+		}
+		return reserved;
+	}
+
+private:
+	void grow(std::size_t minimum)
+	{
+		std::size_t size = std::max(mNextChunkSize, minimum);
+		mCurrent = static_cast<char*>(mUpstream->allocate(size, alignof(std::max_align_t)));
+		mRemaining = size;
+		mChunks.emplace_back(mCurrent, size);
+		mNextChunkSize = std::min<std::size_t>(mNextChunkSize * 2, std::size_t(1) << 28);
+	}
+
+	MemoryResource* mUpstream;
+	std::size_t mNextChunkSize;
+	char* mCurrent;
+	std::size_t mRemaining;
+	std::size_t mAllocated;
+	std::vector<std::pair<char*, std::size_t> > mChunks;
+};
+
+//! Huge Page Resource
+/*!
+   Serves blocks of at least 2 MiB from anonymous memory mappings aligned to 2 MiB and advised to use transparent huge pages, which reduces TLB pressure on large Properties. Smaller blocks come from the upstream resource.
+   \remarks Huge pages are only requested on Linux. Elsewhere, every block comes from the upstream resource.
+ */
+class HugePageResource final : public MemoryResource
+{
+public:
+	static constexpr std::size_t kHugePageSize = std::size_t(1) << 21;
+
+	explicit HugePageResource(MemoryResource* upstream = defaultResource()) :
+		mUpstream(upstream)
+	{
+
+	}
+
+	void* allocate(std::size_t bytes, std::size_t alignment) override
+	{
+#ifdef __linux__
+		if(bytes >= kHugePageSize && alignment <= kHugePageSize)
+		{
+			std::size_t mapped = roundUp(bytes) + kHugePageSize;
+			void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(raw == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+			char* aligned = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(raw) + kHugePageSize - 1) & ~(kHugePageSize - 1));
+			char* end = static_cast<char*>(raw) + mapped;
+			if(aligned != raw)
+			{
+				munmap(raw, aligned - static_cast<char*>(raw));
+			}
+			if(end != aligned + roundUp(bytes))
+			{
+				munmap(aligned + roundUp(bytes), end - (aligned + roundUp(bytes)));
+			}
+#ifdef MADV_HUGEPAGE
+			madvise(aligned, roundUp(bytes), MADV_HUGEPAGE);
+#endif
+			return aligned;
+		}
+#endif
+		return mUpstream->allocate(bytes, alignment);
+	}
+
+	void deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+#ifdef __linux__
+		if(bytes >= kHugePageSize && alignment <= kHugePageSize)
+		{
+			munmap(p, roundUp(bytes));
+			return;
+		}
+#endif
+		mUpstream->deallocate(p, bytes, alignment);
+	}
+
+private:
+	static std::size_t roundUp(std::size_t bytes)
+	{
+		return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+	}
+
+	MemoryResource* mUpstream;
+};
+
+//! Polymorphic Allocator
+/*!
+   A std::allocator replacement that forwards to a MemoryResource, so containers of the same type can draw memory from different resources.
+ */
+template <class T>
+class PolymorphicAllocator
+{
+public:
+	using value_type = T;
+
+	PolymorphicAllocator(MemoryResource* resource = defaultResource()) noexcept :
+		mResource(resource)
+	{
+
+	}
+
+	template <class U>
+	PolymorphicAllocator(const PolymorphicAllocator<U>& other) noexcept :
+		mResource(other.resource())
+	{
+
+	}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(mResource->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept
+	{
+		mResource->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	PolymorphicAllocator select_on_container_copy_construction() const
+	{
+		return *this;
+	}
+
+	MemoryResource* resource() const noexcept
+	{
+		return mResource;
+	}
+
+	template <class U>
+	bool operator==(const PolymorphicAllocator<U>& other) const noexcept
+	{
+		return mResource == other.resource();
+	}
+
+	template <class U>
+	bool operator!=(const PolymorphicAllocator<U>& other) const noexcept
+	{
+		return mResource != other.resource();
+	}
+
+private:
+	MemoryResource* mResource;
+};
+
+} // namespace util
+} // namespace ophidian
+
+#endif // OPHIDIAN_UTIL_MEMORYRESOURCE_H
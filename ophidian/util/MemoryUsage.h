@@ -0,0 +1,175 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_UTIL_MEMORYUSAGE_H
+#define OPHIDIAN_UTIL_MEMORYUSAGE_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ophidian
+{
+namespace util
+{
+
+//! Memory Usage report
+/*!
+   A node of a hierarchical memory report: the number of elements and the capacity of a container, the heap bytes it owns directly, and the reports of its parts.
+   Heap bytes include the buffers owned by the elements, such as long strings, and an estimate of the nodes and buckets of hash maps.
+ */
+struct MemoryUsage
+{
+	MemoryUsage(std::string name = std::string(), std::size_t size = 0, std::size_t capacity = 0, std::size_t bytes = 0) :
+		name(std::move(name)),
+		size(size),
+		capacity(capacity),
+		bytes(bytes)
+	{
+
+	}
+
+	//! Add a part
+	/*!
+	   \brief Appends \p child, renamed to \p name, to the parts of this report.
+	   \return This report, so calls can be chained.
+	 */
+	MemoryUsage & add(std::string name, MemoryUsage child)
+	{
+		child.name = std::move(name);
+		children.push_back(std::move(child));
+		return *this;
+	}
+
+	//! Total heap bytes
+	/*!
+	   \return The heap bytes of this node and of all its parts.
+	 */
+	std::size_t totalBytes() const
+	{
+		std::size_t total = bytes;
+		for(auto const & child : children)
+		{
+			total += child.totalBytes();
+		}
+		return total;
+	}
+
+	std::string name;
+	std::size_t size;
+	std::size_t capacity;
+	std::size_t bytes;
+	std::vector<MemoryUsage> children;
+};
+
+//! Heap bytes owned by a value
+/*!
+   \brief Returns the heap bytes owned by \p value besides its own storage. Overloaded for the types that own buffers.
+ */
+template <class T>
+std::size_t heapBytes(const T & value)
+{
+	return 0;
+}
+
+inline std::size_t heapBytes(const std::string & value)
+{
+	const char * data = value.data();
+	const char * object = reinterpret_cast<const char *>(&value);
+	// short strings live inside the object
+	if(data >= object && data < object + sizeof(value))
+	{
+		return 0;
+	}
+	return value.capacity() + 1;
+}
+
+template <class T, class U>
+std::size_t heapBytes(const std::pair<T, U> & value)
+{
+	return heapBytes(value.first) + heapBytes(value.second);
+}
+
+//! Memory usage of a vector
+/*!
+   \brief Reports the size, the capacity and the heap bytes of \p container, including the buffers owned by its elements.
+ */
+template <class T, class Allocator>
+MemoryUsage memoryUsage(const std::vector<T, Allocator> & container)
+{
+	MemoryUsage usage("vector", container.size(), container.capacity(), container.capacity() * sizeof(T));
+	for(auto const & element : container)
+	{
+		usage.bytes += heapBytes(element);
+	}
+	return usage;
+}
+
+template <class Allocator>
+MemoryUsage memoryUsage(const std::vector<bool, Allocator> & container)
+{
+	return MemoryUsage("vector", container.size(), container.capacity(), container.capacity() / 8);
+}
+
+//! Memory usage of a hash map
+/*!
+   \brief Estimates the heap bytes of \p map: its bucket array, one node per element (the element, a next pointer and a cached hash) and the buffers owned by the elements.
+ */
+template <class Key, class Value, class Hash, class Equal, class Allocator>
+MemoryUsage memoryUsage(const std::unordered_map<Key, Value, Hash, Equal, Allocator> & map)
+{
+	const std::size_t node = sizeof(typename std::unordered_map<Key, Value, Hash, Equal, Allocator>::value_type) + sizeof(void *) + sizeof(std::size_t);
+	MemoryUsage usage("unordered_map", map.size(), map.bucket_count(), map.bucket_count() * sizeof(void *) + map.size() * node);
+	for(auto const & element : map)
+	{
+		usage.bytes += heapBytes(element);
+	}
+	return usage;
+}
+
+//! Print a memory report
+/*!
+   \brief Writes \p usage as an indented tree, one line per node with its total bytes, size and capacity.
+ */
+inline void print(std::ostream & out, const MemoryUsage & usage, std::size_t depth = 0)
+{
+	out << std::string(2 * depth, ' ') << usage.name << ": " << usage.totalBytes() << " bytes";
+	if(usage.capacity != 0 || usage.size != 0)
+	{
+		out << " (size " << usage.size << ", capacity " << usage.capacity << ")";
+	}
+	out << '\n';
+	for(auto const & child : usage.children)
+	{
+		print(out, child, depth + 1);
+	}
+}
+
+inline std::ostream & operator<<(std::ostream & out, const MemoryUsage & usage)
+{
+	print(out, usage);
+	return out;
+}
+
+} // namespace util
+} // namespace ophidian
+
+#endif // OPHIDIAN_UTIL_MEMORYUSAGE_H
@@ -0,0 +1,430 @@
+/*
+ * Copyright 2017 Ophidian
+   Licensed to the Apache Software Foundation (ASF) under one
+   or more contributor license agreements.  See the NOTICE file
+   distributed with this work for additional information
+   regarding copyright ownership.  The ASF licenses this file
+   to you under the Apache License, Version 2.0 (the
+   "License"); you may not use this file except in compliance
+   with the License.  You may obtain a copy of the License at
+   http://www.apache.org/licenses/LICENSE-2.0
+   Unless required by applicable law or agreed to in writing,
+   software distributed under the License is distributed on an
+   "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+   KIND, either express or implied.  See the License for the
+   specific language governing permissions and limitations
+   under the License.
+ */
+
+#ifndef OPHIDIAN_UTIL_STRINGPOOL_H
+#define OPHIDIAN_UTIL_STRINGPOOL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+#include <ophidian/util/MemoryUsage.h>
+
+namespace ophidian
+{
+namespace util
+{
+
+//! Non-owning view of a string
+using StringView = boost::string_ref;
+
+//! Interned string id
+using Symbol = std::uint32_t;
+
+//! Invalid symbol, returned when a string was not interned
+constexpr Symbol kInvalidSymbol = std::numeric_limits<Symbol>::max();
+
+//! String Pool
+/*!
+   An interning arena: stores each distinct string once, in a single character buffer, and hands out 4-byte symbols for them.
+   Strings are looked up by an open-addressing hash table of symbols, so lookups do not allocate and intern() hashes and probes once whether the string is new or not.
+   Once the strings are known, e.g. after a design is loaded, freeze() replaces that table by a perfect hash: a displacement table of 4 bits per string, small enough to stay in cache, and a table of slots at 80% load where each string has exactly one possible slot. Strings interned later go to a small open-addressing overlay.
+   Strings are never removed; symbols stay valid for the lifetime of the pool. Views returned by view() are invalidated by the next intern() of a new string.
+ */
+class StringPool
+{
+public:
+	StringPool() :
+		mOffsets(1, 0),
+		mSlots(std::size_t(kInitialSlots), kInvalidSymbol),
+		mFrozenSize(0)
+	{
+
+	}
+
+	//! Intern a string
+	/*!
+	   \brief Returns the symbol of \p string, adding it to the pool if it is new.
+	   \param string The string to intern.
+	   \return The symbol of \p string.
+	 */
+	Symbol intern(StringView string)
+	{
+		auto hashValue = hash(string);
+		auto symbol = findFrozen(string, hashValue);
+		if(symbol != kInvalidSymbol)
+		{
+			return symbol;
+		}
+		auto slot = probe(string, static_cast<std::uint32_t>(hashValue));
+		if(mSlots[slot] != kInvalidSymbol)
+		{
+			return mSlots[slot];
+		}
+		symbol = static_cast<Symbol>(size());
+		if(!mCharacters.empty() && string.data() >= mCharacters.data() && string.data() < mCharacters.data() + mCharacters.size())
+		{
+			// a view into the pool itself would dangle when the buffer grows
+			std::string copy(string.data(), string.size());
+			mCharacters.insert(mCharacters.end(), copy.begin(), copy.end());
+		}
+		else
+		{
+			mCharacters.insert(mCharacters.end(), string.begin(), string.end());
+		}
+		mOffsets.push_back(mCharacters.size());
+		mHashes.push_back(static_cast<std::uint32_t>(hashValue));
+		mSlots[slot] = symbol;
+		if(2 * overlaySize() > mSlots.size())
+		{
+			rehash(2 * mSlots.size());
+		}
+		return symbol;
+	}
+
+	//! Find a string
+	/*!
+	   \brief Looks \p string up without adding it.
+	   \return The symbol of \p string, or kInvalidSymbol if it was never interned.
+	 */
+	Symbol find(StringView string) const
+	{
+		auto hashValue = hash(string);
+		auto symbol = findFrozen(string, hashValue);
+		if(symbol != kInvalidSymbol)
+		{
+			return symbol;
+		}
+		return mSlots[probe(string, static_cast<std::uint32_t>(hashValue))];
+	}
+
+	//! Freeze the pool
+	/*!
+	   \brief Builds a perfect hash over every string interned so far, shrinks the open-addressing table to the strings interned afterwards and releases the spare capacity of the character buffer.
+	   The pool stays mutable: it can be frozen again, e.g. after a second file is read, to move the newer strings to the perfect hash.
+	 */
+	void freeze()
+	{
+		std::size_t size = this->size();
+		std::size_t buckets = std::max<std::size_t>(1, size / kBucketSize);
+		std::size_t slotCount = std::max<std::size_t>(1, size + size / kSpareSlots);
+		std::vector<std::uint64_t> hashes(size);
+		std::vector<std::uint32_t> first(buckets + 1, 0);
+		for(Symbol symbol = 0; symbol < size; ++symbol)
+		{
+			hashes[symbol] = hash(view(symbol));
+			++first[bucket(hashes[symbol], buckets) + 1];
+		}
+		for(std::size_t b = 0; b < buckets; ++b)
+		{
+			first[b + 1] += first[b];
+		}
+		std::vector<Symbol> members(size);
+		{
+			auto next = first;
+			for(Symbol symbol = 0; symbol < size; ++symbol)
+			{
+				members[next[bucket(hashes[symbol], buckets)]++] = symbol;
+			}
+		}
+		// larger buckets are placed first, while the table is mostly empty
+		std::vector<std::uint32_t> order(buckets);
+		for(std::uint32_t b = 0; b < buckets; ++b)
+		{
+			order[b] = b;
+		}
+		std::stable_sort(order.begin(), order.end(), [&first](std::uint32_t a, std::uint32_t b) {
+			return first[a + 1] - first[a] > first[b + 1] - first[b];
+		});
+
+		std::vector<std::uint16_t> displacements(buckets, std::uint16_t(kUnplaced));
+		std::vector<FrozenEntry> frozen(slotCount, FrozenEntry{0, kInvalidSymbol});
+		std::vector<Symbol> unplaced;
+		std::vector<std::size_t> slots;
+		for(auto b : order)
+		{
+			auto begin = members.begin() + first[b];
+			auto end = members.begin() + first[b + 1];
+			if(begin == end)
+			{
+				break;
+			}
+			for(std::uint16_t displacement = 0; displacement < kUnplaced; ++displacement)
+			{
+				slots.clear();
+				for(auto member = begin; member != end; ++member)
+				{
+					auto slot = position(hashes[*member], displacement, slotCount);
+					if(frozen[slot].symbol != kInvalidSymbol || std::find(slots.begin(), slots.end(), slot) != slots.end())
+					{
+						break;
+					}
+					slots.push_back(slot);
+				}
+				if(slots.size() == static_cast<std::size_t>(end - begin))
+				{
+					displacements[b] = displacement;
+					for(std::size_t i = 0; i < slots.size(); ++i)
+					{
+						frozen[slots[i]] = FrozenEntry{static_cast<std::uint32_t>(hashes[begin[i]]), begin[i]};
+					}
+					break;
+				}
+			}
+			if(displacements[b] == kUnplaced)
+			{
+				// strings whose hashes collide for every displacement stay in the overlay
+				unplaced.insert(unplaced.end(), begin, end);
+			}
+		}
+
+		mDisplacements.swap(displacements);
+		mFrozen.swap(frozen);
+		mUnplaced.swap(unplaced);
+		mFrozenSize = static_cast<Symbol>(size);
+		// the hashes of frozen strings live in the perfect hash now
+		std::vector<std::uint32_t>().swap(mHashes);
+		mCharacters.shrink_to_fit();
+		mOffsets.shrink_to_fit();
+		std::size_t overlay = kInitialSlots;
+		while(overlay < 2 * overlaySize() + 1)
+		{
+			overlay *= 2;
+		}
+		rehash(overlay);
+	}
+
+	//! Number of frozen strings
+	/*!
+	   \return The number of strings found through the perfect hash built by the last freeze().
+	 */
+	std::size_t frozen() const
+	{
+		return mFrozenSize - mUnplaced.size();
+	}
+
+	//! View of an interned string
+	StringView view(Symbol symbol) const
+	{
+		return StringView(mCharacters.data() + mOffsets[symbol], mOffsets[symbol + 1] - mOffsets[symbol]);
+	}
+
+	//! Copy of an interned string
+	std::string str(Symbol symbol) const
+	{
+		return std::string(mCharacters.data() + mOffsets[symbol], mOffsets[symbol + 1] - mOffsets[symbol]);
+	}
+
+	//! Number of interned strings
+	std::size_t size() const
+	{
+		return mOffsets.size() - 1;
+	}
+
+	//! Allocate space
+	/*!
+	   \brief Reserves space for \p strings strings with \p characters characters in total.
+	 */
+	void reserve(std::size_t strings, std::size_t characters)
+	{
+		mCharacters.reserve(characters);
+		mOffsets.reserve(strings + 1);
+		mHashes.reserve(strings - std::min<std::size_t>(strings, mFrozenSize));
+		std::size_t slots = mSlots.size();
+		while(slots < 2 * (strings - std::min<std::size_t>(strings, frozen())))
+		{
+			slots *= 2;
+		}
+		if(slots != mSlots.size())
+		{
+			rehash(slots);
+		}
+	}
+
+	//! Memory usage
+	/*!
+	   \brief Reports the characters and offsets of each string, the open-addressing table with the hashes of its strings, and the perfect hash, if frozen.
+	 */
+	MemoryUsage memoryUsage() const
+	{
+		MemoryUsage usage("StringPool", size(), mOffsets.capacity() - 1);
+		usage.add("characters", util::memoryUsage(mCharacters));
+		usage.add("offsets", util::memoryUsage(mOffsets));
+		usage.add("hashes", util::memoryUsage(mHashes));
+		usage.add("slots", util::memoryUsage(mSlots));
+		if(mFrozenSize != 0)
+		{
+			usage.add("displacements", util::memoryUsage(mDisplacements));
+			usage.add("frozen", util::memoryUsage(mFrozen));
+			usage.add("unplaced", util::memoryUsage(mUnplaced));
+		}
+		return usage;
+	}
+
+	//! Hash of a string
+	/*!
+	   \brief FNV-1a followed by a 64-bit finalizer, so both halves of the value are well mixed.
+	 */
+	static std::uint64_t hash(StringView string)
+	{
+		std::uint64_t value = 14695981039346656037ull;
+		for(auto character : string)
+		{
+			value = (value ^ static_cast<unsigned char>(character)) * 1099511628211ull;
+		}
+		return mix(value);
+	}
+
+private:
+	static constexpr std::size_t kInitialSlots = 16;
+	//! Average number of strings sharing a displacement
+	static constexpr std::size_t kBucketSize = 4;
+	//! One spare slot in the perfect hash for every kSpareSlots strings, which keeps the displacement search short
+	static constexpr std::size_t kSpareSlots = 4;
+	//! Displacement of the buckets that could not be placed; also the number of displacements tried
+	static constexpr std::uint16_t kUnplaced = std::numeric_limits<std::uint16_t>::max();
+
+	static std::uint64_t mix(std::uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	//! Maps the upper half of \p value to [0, range) with a multiplication instead of a division
+	static std::size_t reduce(std::uint64_t value, std::size_t range)
+	{
+		return ((value >> 32) * range) >> 32;
+	}
+
+	static std::size_t bucket(std::uint64_t hashValue, std::size_t buckets)
+	{
+		return reduce(hashValue, buckets);
+	}
+
+	static std::size_t position(std::uint64_t hashValue, std::uint16_t displacement, std::size_t size)
+	{
+		return reduce(mix(hashValue ^ (displacement * 0x9e3779b97f4a7c15ull)), size);
+	}
+
+	//! Lower half of the hash of a string in the open-addressing table
+	std::uint32_t hashOf(Symbol symbol) const
+	{
+		if(symbol < mFrozenSize)
+		{
+			// only strings the perfect hash could not place
+			return static_cast<std::uint32_t>(hash(view(symbol)));
+		}
+		return mHashes[symbol - mFrozenSize];
+	}
+
+	//! Number of strings in the open-addressing table
+	std::size_t overlaySize() const
+	{
+		return size() - mFrozenSize + mUnplaced.size();
+	}
+
+	//! Symbol of \p string in the perfect hash, or kInvalidSymbol
+	Symbol findFrozen(StringView string, std::uint64_t hashValue) const
+	{
+		if(mFrozen.empty())
+		{
+			return kInvalidSymbol;
+		}
+		auto displacement = mDisplacements[bucket(hashValue, mDisplacements.size())];
+		if(displacement == kUnplaced)
+		{
+			return kInvalidSymbol;
+		}
+		auto slot = position(hashValue, displacement, mFrozen.size());
+		auto const & entry = mFrozen[slot];
+		if(entry.hash == static_cast<std::uint32_t>(hashValue) && entry.symbol != kInvalidSymbol && view(entry.symbol) == string)
+		{
+			return entry.symbol;
+		}
+		return kInvalidSymbol;
+	}
+
+	//! Slot holding \p string, or the empty slot where it would be inserted
+	std::size_t probe(StringView string, std::uint32_t hashValue) const
+	{
+		std::size_t mask = mSlots.size() - 1;
+		for(std::size_t slot = hashValue & mask;; slot = (slot + 1) & mask)
+		{
+			Symbol symbol = mSlots[slot];
+			if(symbol == kInvalidSymbol || (hashOf(symbol) == hashValue && view(symbol) == string))
+			{
+				return slot;
+			}
+		}
+	}
+
+	void insert(Symbol symbol)
+	{
+		std::size_t mask = mSlots.size() - 1;
+		std::size_t slot = hashOf(symbol) & mask;
+		while(mSlots[slot] != kInvalidSymbol)
+		{
+			slot = (slot + 1) & mask;
+		}
+		mSlots[slot] = symbol;
+	}
+
+	void rehash(std::size_t slots)
+	{
+		std::vector<Symbol>(slots, kInvalidSymbol).swap(mSlots);
+		for(auto symbol : mUnplaced)
+		{
+			insert(symbol);
+		}
+		for(Symbol symbol = mFrozenSize; symbol < size(); ++symbol)
+		{
+			insert(symbol);
+		}
+	}
+
+	//! Slot of the perfect hash
+	struct FrozenEntry
+	{
+		std::uint32_t hash;
+		Symbol symbol;
+	};
+
+	std::vector<char> mCharacters;
+	std::vector<std::uint64_t> mOffsets;
+
+	//open-addressing table of the strings interned since the last freeze()
+	std::vector<std::uint32_t> mHashes;
+	std::vector<Symbol> mSlots;
+
+	//perfect hash built by freeze()
+	std::vector<std::uint16_t> mDisplacements;
+	std::vector<FrozenEntry> mFrozen;
+	std::vector<Symbol> mUnplaced;
+	Symbol mFrozenSize;
+};
+
+} // namespace util
+} // namespace ophidian
+
+#endif // OPHIDIAN_UTIL_STRINGPOOL_H
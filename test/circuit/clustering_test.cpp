@@ -0,0 +1,145 @@
+#include "netlist_builder.h"
+#include <catch.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/Clustering.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+//! Two cliques of four Cells, c0..c3 and c4..c7, joined by a Net between c3 and c4
+class CliquesFixture : public NetlistBuilder
+{
+public:
+    explicit CliquesFixture(ophidian::util::StringPool* names = nullptr) :
+        NetlistBuilder(8, names)
+    {
+        for(std::size_t clique = 0; clique < 2; ++clique)
+        {
+            for(std::size_t a = 0; a < 4; ++a)
+            {
+                for(std::size_t b = a + 1; b < 4; ++b)
+                {
+                    connect({clique * 4 + a, clique * 4 + b});
+                }
+            }
+        }
+        connect({3, 4});
+        connect({0, 1});
+    }
+};
+
+class SharedNamesFixture
+{
+public:
+    SharedNamesFixture() :
+        cliques(&names)
+    {
+    }
+
+    ophidian::util::StringPool names;
+    CliquesFixture cliques;
+};
+} // namespace
+
+TEST_CASE_METHOD(CliquesFixture, "Clustering: first choice", "[circuit][Clustering]")
+{
+    Hypergraph hypergraph(netlist);
+    Clustering clustering(netlist, hypergraph, {}, ClusteringOptions(ClusteringOptions::Scheme::FirstChoice, 4.0));
+    auto & clusters = clustering.netlist();
+    REQUIRE( clusters.size(Cell()) < 8 );
+    std::size_t members = 0;
+    for(auto cluster = clusters.begin(Cell()); cluster != clusters.end(Cell()); ++cluster)
+    {
+        REQUIRE( clustering.weight(*cluster) <= 4.0 );
+        REQUIRE( clustering.weight(*cluster) == clustering.members(*cluster).size() );
+        REQUIRE( clusters.name(*cluster) == netlist.name(*clustering.members(*cluster).begin()) );
+        for(auto cell : clustering.members(*cluster))
+        {
+            REQUIRE( clustering.cluster(cell) == *cluster );
+            ++members;
+        }
+    }
+    REQUIRE( members == 8 );
+
+    // every Net of the original Netlist between two clusters is merged into a Net of the clustered one
+    std::uint32_t weights = 0;
+    for(auto net = clusters.begin(Net()); net != clusters.end(Net()); ++net)
+    {
+        std::set<std::string> netClusters;
+        for(auto pin : clusters.pins(*net))
+        {
+            netClusters.insert(clusters.name(clusters.cell(pin)));
+        }
+        REQUIRE( netClusters.size() == clusters.pins(*net).size() );
+        REQUIRE( netClusters.size() >= 2 );
+        weights += clustering.weight(*net);
+    }
+    std::uint32_t external = 0;
+    for(auto net = netlist.begin(Net()); net != netlist.end(Net()); ++net)
+    {
+        std::set<std::string> netClusters;
+        for(auto pin : netlist.pins(*net))
+        {
+            netClusters.insert(clusters.name(clustering.cluster(netlist.cell(pin))));
+        }
+        external += netClusters.size() > 1;
+    }
+    REQUIRE( weights == external );
+}
+
+TEST_CASE_METHOD(CliquesFixture, "Clustering: heavy edge matching", "[circuit][Clustering]")
+{
+    Hypergraph hypergraph(netlist);
+    Clustering clustering(netlist, hypergraph, {}, ClusteringOptions(ClusteringOptions::Scheme::HeavyEdge));
+    auto & clusters = clustering.netlist();
+    REQUIRE( clusters.size(Cell()) >= 4 );
+    REQUIRE( clusters.size(Cell()) < 8 );
+    for(auto cluster = clusters.begin(Cell()); cluster != clusters.end(Cell()); ++cluster)
+    {
+        REQUIRE( clustering.members(*cluster).size() <= 2 );
+    }
+}
+
+TEST_CASE_METHOD(CliquesFixture, "Clustering: weighted cells", "[circuit][Clustering]")
+{
+    Hypergraph hypergraph(netlist);
+    std::vector<double> weights(8, 1.0);
+    weights[hypergraph.index(cells[0])] = 10.0;
+    Clustering clustering(netlist, hypergraph, weights, ClusteringOptions(ClusteringOptions::Scheme::FirstChoice, 4.0));
+    auto heavy = clustering.cluster(cells[0]);
+    REQUIRE( clustering.members(heavy).size() == 1 );
+    REQUIRE( clustering.weight(heavy) == 10.0 );
+}
+
+TEST_CASE_METHOD(CliquesFixture, "Clustering: the result does not depend on the number of threads", "[circuit][Clustering]")
+{
+    Hypergraph hypergraph(netlist);
+    ClusteringOptions serial;
+    serial.seed = 3;
+    serial.parallel = ophidian::entity_system::ParallelOptions(2, 1);
+    ClusteringOptions parallel = serial;
+    parallel.parallel = ophidian::entity_system::ParallelOptions(2, 4);
+    Clustering first(netlist, hypergraph, {}, serial);
+    Clustering second(netlist, hypergraph, {}, parallel);
+    for(auto cell : cells)
+    {
+        REQUIRE( first.netlist().name(first.cluster(cell)) == second.netlist().name(second.cluster(cell)) );
+    }
+    REQUIRE( first.netlist().size(Net()) == second.netlist().size(Net()) );
+}
+
+TEST_CASE_METHOD(SharedNamesFixture, "Clustering: a shared name pool interns no new names", "[circuit][Clustering]")
+{
+    Hypergraph hypergraph(cliques.netlist);
+    auto interned = names.size();
+    Clustering clustering(cliques.netlist, hypergraph, {}, ClusteringOptions(), &names);
+    REQUIRE( clustering.netlist().size(Cell()) < 8 );
+    REQUIRE( names.size() == interned );
+    auto usage = clustering.memoryUsage();
+    REQUIRE( usage.children.front().name == "netlist" );
+    REQUIRE( usage.size == 8 );
+}
@@ -0,0 +1,159 @@
+#include "inverter_netlist.h"
+#include <catch.hpp>
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/ConeQuery.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+//! in -> u0 -> u1 -> u2 -> u3 -> out, with u0 also driving u4
+class ChainFixture : public InverterNetlist
+{
+public:
+    ChainFixture()
+    {
+        for(int i = 0; i < 5; ++i)
+        {
+            auto name = "u" + std::to_string(i);
+            cells.push_back(netlist.add(Cell(), name));
+            inputs.push_back(pin(cells.back(), name + ":a", stdInput));
+            outputs.push_back(pin(cells.back(), name + ":o", stdOutput));
+        }
+        in = netlist.add(Pin(), "in");
+        netlist.add(Input(), in);
+        out = netlist.add(Pin(), "out");
+        netlist.add(Output(), out);
+        connect("n_in", {in, inputs[0]});
+        connect("n0", {outputs[0], inputs[1], inputs[4]});
+        connect("n1", {outputs[1], inputs[2]});
+        connect("n2", {outputs[2], inputs[3]});
+        connect("n3", {outputs[3], out});
+    }
+
+    Net connect(const std::string & name, std::initializer_list<Pin> pins)
+    {
+        auto net = netlist.add(Net(), name);
+        for(auto const & pin : pins)
+        {
+            netlist.connect(net, pin);
+        }
+        return net;
+    }
+
+    Pin in, out;
+    std::vector<Cell> cells;
+    std::vector<Pin> inputs, outputs;
+};
+
+std::vector<Cell> cone(const ConeQuery::Cells & cells)
+{
+    return std::vector<Cell>(cells.begin(), cells.end());
+}
+
+std::vector<std::uint32_t> levels(const ConeQuery & query)
+{
+    return std::vector<std::uint32_t>(query.levels().begin(), query.levels().end());
+}
+} // namespace
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: fan-out cones", "[circuit][ConeQuery]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index);
+    // the Cells found at the same level come in the order of the sinks of their Net, so only the sets are compared
+    REQUIRE( sameItems(query.fanout(outputs[0], 1), std::vector<Cell>({cells[1], cells[4]})) );
+    REQUIRE( levels(query) == std::vector<std::uint32_t>({1, 1}) );
+    REQUIRE( sameItems(query.fanout(inputs[0]), std::vector<Cell>(cells.begin(), cells.end())) );
+    REQUIRE( levels(query) == std::vector<std::uint32_t>({0, 1, 1, 2, 3}) );
+    REQUIRE( sameItems(query.fanout(in, 2), std::vector<Cell>({cells[0], cells[1], cells[4]})) );
+    REQUIRE( cone(query.fanout(cells[2])) == std::vector<Cell>({cells[2], cells[3]}) );
+    REQUIRE( query.fanout(outputs[0], 0).empty() );
+    REQUIRE( query.fanout(outputs[3]).empty() );
+    REQUIRE( query.fanout(out).empty() );
+}
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: fan-in cones", "[circuit][ConeQuery]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index);
+    REQUIRE( cone(query.fanin(out)) == std::vector<Cell>({cells[3], cells[2], cells[1], cells[0]}) );
+    REQUIRE( levels(query) == std::vector<std::uint32_t>({1, 2, 3, 4}) );
+    REQUIRE( cone(query.fanin(outputs[2], 1)) == std::vector<Cell>({cells[2], cells[1]}) );
+    REQUIRE( cone(query.fanin(cells[4])) == std::vector<Cell>({cells[4], cells[0]}) );
+    REQUIRE( query.fanin(inputs[0]).empty() );
+    REQUIRE( query.fanin(in).empty() );
+}
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: loops and repeated queries", "[circuit][ConeQuery]")
+{
+    // u3 -> u0 closes a loop
+    netlist.disconnect(inputs[0]);
+    netlist.connect(netlist.net(outputs[3]), inputs[0]);
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index);
+    for(int i = 0; i < 1000; ++i)
+    {
+        REQUIRE( query.fanout(cells[0]).size() == 5 );
+        REQUIRE( query.fanin(cells[1]).size() == 4 );
+        REQUIRE( query.fanout(outputs[1], 2).size() == 2 );
+    }
+    REQUIRE( sameItems(query.fanout(outputs[3]), std::vector<Cell>(cells.begin(), cells.end())) );
+    REQUIRE( levels(query) == std::vector<std::uint32_t>({1, 2, 2, 3, 4}) );
+}
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: cached cone sizes follow the netlist", "[circuit][ConeQuery]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index, true);
+    REQUIRE( query.fanoutSize(in) == 5 );
+    REQUIRE( query.fanoutSize(in, 1) == 1 );
+    REQUIRE( query.faninSize(out) == 4 );
+    query.fanout(cells[3]);
+    REQUIRE( query.fanoutSize(in) == 5 );
+    REQUIRE( query.levels().size() == 1 );
+
+    netlist.disconnect(inputs[2]);
+    REQUIRE( query.fanoutSize(in) == 3 );
+    REQUIRE( query.faninSize(out) == 2 );
+    netlist.connect(netlist.net(outputs[1]), inputs[2]);
+    REQUIRE( query.fanoutSize(in) == 5 );
+
+    netlist.erase(inputs[4]);
+    REQUIRE( query.fanoutSize(in) == 4 );
+    REQUIRE( query.memoryUsage().totalBytes() > 0 );
+}
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: adding a Pin to a Cell drops the cached sizes", "[circuit][ConeQuery]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index, true);
+    REQUIRE( query.fanoutSize(in) == 5 );
+    auto input = netlist.add(Pin(), "u5:a");
+    mapping.pinStdCell(input, stdInput);
+    netlist.connect(netlist.net(outputs[3]), input);
+    REQUIRE( query.fanoutSize(in) == 5 );
+    auto version = index.version();
+    netlist.add(netlist.add(Cell(), "u5"), input);
+    REQUIRE( index.version() != version );
+    REQUIRE( query.fanoutSize(in) == 6 );
+}
+
+TEST_CASE_METHOD(ChainFixture, "ConeQuery: a change only drops the cached sizes of the cones it reaches", "[circuit][ConeQuery]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    ConeQuery query(netlist, index, true);
+    REQUIRE( query.fanoutSize(in) == 5 );
+    REQUIRE( query.faninSize(inputs[4]) == 1 );
+    REQUIRE( query.fanoutSize(outputs[2], 1) == 1 );
+
+    // u3 is downstream of in and of u2, but not upstream of u4
+    netlist.disconnect(inputs[3]);
+    REQUIRE( query.fanout(cells[0]).size() == 4 );
+    REQUIRE( query.faninSize(inputs[4]) == 1 );
+    REQUIRE( query.levels().size() == 4 );
+    REQUIRE( query.fanoutSize(outputs[2], 1) == 0 );
+    REQUIRE( query.fanoutSize(in) == 4 );
+}
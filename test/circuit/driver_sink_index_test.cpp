@@ -0,0 +1,115 @@
+#include "inverter_netlist.h"
+#include <catch.hpp>
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/DriverSinkIndex.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+//! in -> u1 -> u2 -> out, with u1 also driving u3
+class InvertersFixture : public InverterNetlist
+{
+public:
+    InvertersFixture()
+    {
+        n0 = netlist.add(Net(), "n0");
+        n1 = netlist.add(Net(), "n1");
+        n2 = netlist.add(Net(), "n2");
+        in = netlist.add(Pin(), "in");
+        netlist.add(Input(), in);
+        out = netlist.add(Pin(), "out");
+        netlist.add(Output(), out);
+        netlist.connect(n0, in);
+        for(auto name : {"u1", "u2", "u3"})
+        {
+            cells.push_back(netlist.add(Cell(), name));
+            inputs.push_back(pin(cells.back(), std::string(name) + ":a", stdInput));
+            outputs.push_back(pin(cells.back(), std::string(name) + ":o", stdOutput));
+        }
+        netlist.connect(n0, inputs[0]);
+        netlist.connect(n1, inputs[1]);
+        netlist.connect(n1, outputs[0]);
+        netlist.connect(n1, inputs[2]);
+        netlist.connect(n2, outputs[1]);
+        netlist.connect(n2, out);
+    }
+
+    Net n0, n1, n2;
+    Pin in, out;
+    std::vector<Cell> cells;
+    std::vector<Pin> inputs, outputs;
+};
+} // namespace
+
+TEST_CASE_METHOD(InvertersFixture, "DriverSinkIndex: drivers and sinks of the nets", "[circuit][DriverSinkIndex]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells, ophidian::entity_system::ParallelOptions(1, 2));
+    REQUIRE( index.driver(n0) == in );
+    REQUIRE( index.fanout(n0) == 1 );
+    REQUIRE( *index.sinks(n0).begin() == inputs[0] );
+    REQUIRE( index.driver(n1) == outputs[0] );
+    REQUIRE( index.drivers(n1).size() == 1 );
+    REQUIRE( index.fanout(n1) == 2 );
+    REQUIRE( sameItems(index.sinks(n1), std::vector<Pin>({inputs[1], inputs[2]})) );
+    REQUIRE( index.driver(n2) == outputs[1] );
+    REQUIRE( *index.sinks(n2).begin() == out );
+    REQUIRE( index.drives(outputs[0]) );
+    REQUIRE( !index.drives(inputs[1]) );
+    REQUIRE( !index.drives(outputs[2]) );
+}
+
+TEST_CASE_METHOD(InvertersFixture, "DriverSinkIndex: follows connect and disconnect", "[circuit][DriverSinkIndex]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    netlist.disconnect(inputs[1]);
+    REQUIRE( index.fanout(n1) == 1 );
+    REQUIRE( *index.sinks(n1).begin() == inputs[2] );
+    REQUIRE( index.driver(n1) == outputs[0] );
+
+    netlist.disconnect(outputs[0]);
+    REQUIRE( index.driver(n1) == Pin() );
+    REQUIRE( index.fanout(n1) == 1 );
+
+    netlist.connect(n1, outputs[2]);
+    netlist.connect(n1, inputs[1]);
+    netlist.connect(n1, outputs[0]);
+    REQUIRE( index.drivers(n1).size() == 2 );
+    REQUIRE( sameItems(index.drivers(n1), std::vector<Pin>({outputs[0], outputs[2]})) );
+    REQUIRE( sameItems(index.sinks(n1), std::vector<Pin>({inputs[1], inputs[2]})) );
+
+    netlist.disconnect(outputs[2]);
+    REQUIRE( index.driver(n1) == outputs[0] );
+    REQUIRE( !index.drives(outputs[2]) );
+    REQUIRE( index.fanout(n1) == 2 );
+}
+
+TEST_CASE_METHOD(InvertersFixture, "DriverSinkIndex: follows erased pins and nets", "[circuit][DriverSinkIndex]")
+{
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    netlist.erase(cells[2]);
+    REQUIRE( index.fanout(n1) == 1 );
+    REQUIRE( *index.sinks(n1).begin() == inputs[1] );
+
+    netlist.erase(n1);
+    REQUIRE( !index.drives(outputs[0]) );
+    netlist.connect(n2, inputs[1]);
+    REQUIRE( index.fanout(n2) == 2 );
+    netlist.erase(inputs[1]);
+    REQUIRE( index.fanout(n2) == 1 );
+    REQUIRE( index.driver(n2) == outputs[1] );
+}
+
+TEST_CASE_METHOD(InvertersFixture, "DriverSinkIndex: stops listening when destroyed", "[circuit][DriverSinkIndex]")
+{
+    {
+        DriverSinkIndex index(netlist, mapping, stdCells);
+        REQUIRE( index.memoryUsage().size == 7 );
+    }
+    netlist.disconnect(inputs[2]);
+    netlist.connect(n2, inputs[2]);
+    DriverSinkIndex index(netlist, mapping, stdCells);
+    REQUIRE( index.fanout(n2) == 2 );
+}
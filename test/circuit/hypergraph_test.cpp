@@ -0,0 +1,111 @@
+#include <catch.hpp>
+#include <vector>
+
+#include <ophidian/circuit/Hypergraph.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+class SmallNetlistFixture
+{
+public:
+    SmallNetlistFixture()
+    {
+        u1 = netlist.add(Cell(), "u1");
+        u2 = netlist.add(Cell(), "u2");
+        u3 = netlist.add(Cell(), "u3");
+        n1 = netlist.add(Net(), "n1");
+        n2 = netlist.add(Net(), "n2");
+        n3 = netlist.add(Net(), "n3");
+        n4 = netlist.add(Net(), "n4");
+        connect(n1, u3, "u3:a");
+        connect(n1, u1, "u1:o");
+        connect(n1, u2, "u2:a");
+        connect(n2, u2, "u2:o");
+        connect(n2, u3, "u3:b");
+        connect(n2, Cell(), "out");
+        connect(n3, u1, "u1:a");
+        connect(n3, u1, "u1:b");
+    }
+
+    void connect(const Net & net, const Cell & cell, const std::string & name)
+    {
+        auto pin = netlist.add(Pin(), name);
+        if(cell != Cell())
+        {
+            netlist.add(cell, pin);
+        }
+        netlist.connect(net, pin);
+    }
+
+    Netlist netlist;
+    Cell u1, u2, u3;
+    Net n1, n2, n3, n4;
+};
+
+std::vector<Hypergraph::Index> indices(const Hypergraph::Indices & range)
+{
+    return std::vector<Hypergraph::Index>(range.begin(), range.end());
+}
+} // namespace
+
+TEST_CASE_METHOD(SmallNetlistFixture, "Hypergraph: nets to cells", "[circuit][Hypergraph]")
+{
+    Hypergraph hypergraph(netlist);
+    REQUIRE( hypergraph.size(Cell()) == 3 );
+    REQUIRE( hypergraph.size(Net()) == 4 );
+    REQUIRE( hypergraph.size(Pin()) == 6 );
+    REQUIRE( hypergraph.cell(hypergraph.index(u2)) == u2 );
+    REQUIRE( hypergraph.net(hypergraph.index(n3)) == n3 );
+
+    auto index = [&hypergraph](const Cell & cell) {
+        return hypergraph.index(cell);
+    };
+    REQUIRE( indices(hypergraph.cells(hypergraph.index(n1))) == std::vector<Hypergraph::Index>{index(u1), index(u2), index(u3)} );
+    REQUIRE( indices(hypergraph.cells(hypergraph.index(n2))) == std::vector<Hypergraph::Index>{index(u2), index(u3)} );
+    REQUIRE( indices(hypergraph.cells(hypergraph.index(n3))) == std::vector<Hypergraph::Index>{index(u1)} );
+    REQUIRE( hypergraph.cells(hypergraph.index(n4)).empty() );
+    REQUIRE( hypergraph.netOffsets().size() == 5 );
+    REQUIRE( hypergraph.netOffsets().back() == hypergraph.netCells().size() );
+}
+
+TEST_CASE_METHOD(SmallNetlistFixture, "Hypergraph: cells to nets", "[circuit][Hypergraph]")
+{
+    Hypergraph hypergraph(netlist);
+    auto index = [&hypergraph](const Net & net) {
+        return hypergraph.index(net);
+    };
+    REQUIRE( indices(hypergraph.nets(hypergraph.index(u1))) == std::vector<Hypergraph::Index>{index(n1), index(n3)} );
+    REQUIRE( indices(hypergraph.nets(hypergraph.index(u2))) == std::vector<Hypergraph::Index>{index(n1), index(n2)} );
+    REQUIRE( indices(hypergraph.nets(hypergraph.index(u3))) == std::vector<Hypergraph::Index>{index(n1), index(n2)} );
+    REQUIRE( hypergraph.cellOffsets().back() == hypergraph.cellNets().size() );
+    REQUIRE( hypergraph.memoryUsage().totalBytes() > 0 );
+}
+
+TEST_CASE("Hypergraph: parallel build matches the serial one", "[circuit][Hypergraph]")
+{
+    Netlist netlist;
+    std::vector<Cell> cells;
+    for(int i = 0; i < 500; ++i)
+    {
+        cells.push_back(netlist.add(Cell(), "c" + std::to_string(i)));
+    }
+    for(int i = 0; i < 700; ++i)
+    {
+        auto net = netlist.add(Net(), "n" + std::to_string(i));
+        for(int j = 0; j < 1 + i % 5; ++j)
+        {
+            auto pin = netlist.add(Pin(), "n" + std::to_string(i) + ":" + std::to_string(j));
+            netlist.add(cells[(i * 7 + j * 13) % cells.size()], pin);
+            netlist.connect(net, pin);
+        }
+    }
+    Hypergraph serial(netlist, ophidian::entity_system::ParallelOptions(1024, 1));
+    Hypergraph parallel(netlist, ophidian::entity_system::ParallelOptions(16, 4));
+    REQUIRE( serial.netOffsets() == parallel.netOffsets() );
+    REQUIRE( serial.netCells() == parallel.netCells() );
+    REQUIRE( serial.cellOffsets() == parallel.cellOffsets() );
+    REQUIRE( serial.cellNets() == parallel.cellNets() );
+    REQUIRE( serial.size(Pin()) == 700 / 5 * 15 );
+}
@@ -0,0 +1,47 @@
+#ifndef INVERTER_NETLIST_H
+#define INVERTER_NETLIST_H
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/LibraryMapping.h>
+#include <ophidian/circuit/Netlist.h>
+#include <ophidian/standard_cell/StandardCells.h>
+
+//! A Netlist mapped to a library with a single INV standard cell, with input a and output o
+class InverterNetlist
+{
+public:
+    InverterNetlist() :
+        mapping(netlist)
+    {
+        stdInput = stdCells.add(ophidian::standard_cell::Pin(), "INV:a", ophidian::standard_cell::PinDirection::INPUT);
+        stdOutput = stdCells.add(ophidian::standard_cell::Pin(), "INV:o", ophidian::standard_cell::PinDirection::OUTPUT);
+    }
+
+    //! Adds a Pin to \p cell, mapped to \p stdPin
+    ophidian::circuit::Pin pin(const ophidian::circuit::Cell & cell, const std::string & name, const ophidian::standard_cell::Pin & stdPin)
+    {
+        auto pin = netlist.add(ophidian::circuit::Pin(), name);
+        netlist.add(cell, pin);
+        mapping.pinStdCell(pin, stdPin);
+        return pin;
+    }
+
+    ophidian::standard_cell::StandardCells stdCells;
+    ophidian::standard_cell::Pin stdInput, stdOutput;
+    ophidian::circuit::Netlist netlist;
+    ophidian::circuit::LibraryMapping mapping;
+};
+
+//! Whether \p range holds the items of \p expected, in any order
+template <class Range, class Item>
+bool sameItems(const Range & range, const std::vector<Item> & expected)
+{
+    return static_cast<std::size_t>(std::distance(range.begin(), range.end())) == expected.size() &&
+           std::is_permutation(range.begin(), range.end(), expected.begin());
+}
+
+#endif // INVERTER_NETLIST_H
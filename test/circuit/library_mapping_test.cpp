@@ -51,3 +51,20 @@ TEST_CASE("LibraryMapping: setting the standard cell of a pin", "[library_mappin
     REQUIRE(libraryMapping.pinStdCell(netlistAndStdCellFixture.pin2) == netlistAndStdCellFixture.stdCell4);
     REQUIRE(libraryMapping.pinStdCell(netlistAndStdCellFixture.pin1) != libraryMapping.pinStdCell(netlistAndStdCellFixture.pin2));
 }
+
+TEST_CASE("LibraryMapping: rolling back a tentative remapping", "[library_mapping][cell]") {
+    NetlistAndStdCellFixture netlistAndStdCellFixture;
+    ophidian::circuit::LibraryMapping libraryMapping(netlistAndStdCellFixture.netlist);
+    libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1, netlistAndStdCellFixture.stdCell1);
+
+    libraryMapping.checkpoint();
+    libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1, netlistAndStdCellFixture.stdCell2);
+    REQUIRE(libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1) == netlistAndStdCellFixture.stdCell2);
+    libraryMapping.rollback();
+    REQUIRE(libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1) == netlistAndStdCellFixture.stdCell1);
+
+    libraryMapping.checkpoint();
+    libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1, netlistAndStdCellFixture.stdCell2);
+    libraryMapping.commit();
+    REQUIRE(libraryMapping.cellStdCell(netlistAndStdCellFixture.cell1) == netlistAndStdCellFixture.stdCell2);
+}
@@ -0,0 +1,37 @@
+#ifndef NETLIST_BUILDER_H
+#define NETLIST_BUILDER_H
+
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/Netlist.h>
+
+//! A Netlist of Cells c0, c1..., with Nets n0, n1... added one Pin per Cell
+class NetlistBuilder
+{
+public:
+    explicit NetlistBuilder(std::size_t cells, ophidian::util::StringPool* names = nullptr) :
+        netlist(ophidian::util::defaultResource(), names)
+    {
+        for(std::size_t cell = 0; cell < cells; ++cell)
+        {
+            this->cells.push_back(netlist.add(ophidian::circuit::Cell(), "c" + std::to_string(cell)));
+        }
+    }
+
+    void connect(const std::vector<std::size_t> & cells)
+    {
+        auto net = netlist.add(ophidian::circuit::Net(), "n" + std::to_string(netlist.size(ophidian::circuit::Net())));
+        for(auto cell : cells)
+        {
+            auto pin = netlist.add(ophidian::circuit::Pin(), "p" + std::to_string(netlist.size(ophidian::circuit::Pin())));
+            netlist.add(this->cells[cell], pin);
+            netlist.connect(net, pin);
+        }
+    }
+
+    ophidian::circuit::Netlist netlist;
+    std::vector<ophidian::circuit::Cell> cells;
+};
+
+#endif // NETLIST_BUILDER_H
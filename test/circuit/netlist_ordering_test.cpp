@@ -0,0 +1,81 @@
+#include <catch.hpp>
+#include <algorithm>
+
+#include <ophidian/circuit/NetlistOrdering.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+//! A chain of cells c0 - c1 - ... - c(n-1), created in a scrambled order, plus a net connecting all of them
+class ChainFixture
+{
+public:
+    ChainFixture() :
+        chain(8)
+    {
+        std::vector<int> creation{5, 0, 7, 2, 4, 1, 6, 3};
+        for(auto index : creation)
+        {
+            chain[index] = netlist.add(Cell(), "c" + std::to_string(index));
+        }
+        for(int index = 0; index + 1 < 8; ++index)
+        {
+            auto net = netlist.add(Net(), "n" + std::to_string(index));
+            auto out = netlist.add(Pin(), "c" + std::to_string(index) + ":o");
+            auto in = netlist.add(Pin(), "c" + std::to_string(index + 1) + ":i");
+            netlist.add(chain[index], out);
+            netlist.add(chain[index + 1], in);
+            netlist.connect(net, out);
+            netlist.connect(net, in);
+        }
+        auto clock = netlist.add(Net(), "clk");
+        for(int index = 0; index < 8; ++index)
+        {
+            auto ck = netlist.add(Pin(), "c" + std::to_string(index) + ":ck");
+            netlist.add(chain[index], ck);
+            netlist.connect(clock, ck);
+        }
+    }
+
+    //! Position of each chain cell after applying order
+    std::vector<long> positions(const std::vector<uint32_t> & order)
+    {
+        netlist.permute(Cell(), order);
+        std::vector<long> result;
+        for(auto const & cell : chain)
+        {
+            result.push_back(std::find(netlist.begin(Cell()), netlist.end(Cell()), cell) - netlist.begin(Cell()));
+        }
+        return result;
+    }
+
+    Netlist netlist;
+    std::vector<Cell> chain;
+};
+}
+
+TEST_CASE_METHOD(ChainFixture, "NetlistOrdering: breadth-first order keeps neighbours close", "[circuit][NetlistOrdering]")
+{
+    auto order = breadthFirstOrder(netlist, 4);
+    std::vector<uint32_t> sorted(order);
+    std::sort(sorted.begin(), sorted.end());
+    REQUIRE(sorted == std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+
+    auto position = positions(order);
+    for(int index = 0; index + 1 < 8; ++index)
+    {
+        REQUIRE(std::abs(position[index] - position[index + 1]) <= 2);
+    }
+    REQUIRE(netlist.cell(netlist.find(Pin(), "c3:ck")) == chain[3]);
+}
+
+TEST_CASE_METHOD(ChainFixture, "NetlistOrdering: reverse Cuthill-McKee order of a chain", "[circuit][NetlistOrdering]")
+{
+    auto position = positions(reverseCuthillMcKeeOrder(netlist, 4));
+    INFO("A chain starts from one of its ends and gets bandwidth 1");
+    for(int index = 0; index + 1 < 8; ++index)
+    {
+        REQUIRE(std::abs(position[index] - position[index + 1]) == 1);
+    }
+}
@@ -1,5 +1,7 @@
 #include "netlist_test.h"
 #include <catch.hpp>
+#include <algorithm>
+#include <sstream>
 
 #include <ophidian/circuit/Netlist.h>
 
@@ -57,6 +59,20 @@ TEST_CASE("Netlist: Try add the same cell twice.", "[circuit][Netlist]")
 	REQUIRE(nl.size(Net()) == 0);
 }
 
+TEST_CASE("Netlist: Add many Cells.", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto existing = nl.add(Cell(), "cell1");
+	auto cells = nl.add(Cell(), std::vector<std::string>{"cell0", "cell1", "cell2", "cell0"});
+	REQUIRE(nl.size(Cell()) == 3);
+	REQUIRE(cells.size() == 4);
+	REQUIRE(cells[1] == existing);
+	REQUIRE(cells[0] == cells[3]);
+	REQUIRE(nl.name(cells[0]) == "cell0");
+	REQUIRE(nl.name(cells[2]) == "cell2");
+	REQUIRE(nl.find(Cell(), "cell2") == cells[2]);
+}
+
 TEST_CASE("Netlist: Add Pin.", "[circuit][Netlist]")
 {
 	Netlist nl;
@@ -155,6 +171,25 @@ TEST_CASE("Netlist: Connect/Disconnect Net and Pin.", "[circuit][Netlist]")
 	REQUIRE(nl.net(pin) == Net());
 }
 
+TEST_CASE("Netlist: Freeze connectivity.", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto cell = nl.add(Cell(), "cell");
+	auto net = nl.add(Net(), "net");
+	auto pin1 = nl.add(Pin(), "cell:a");
+	auto pin2 = nl.add(Pin(), "cell:b");
+	nl.add(cell, pin1);
+	nl.add(cell, pin2);
+	nl.connect(net, pin1);
+	nl.freezeConnectivity();
+	REQUIRE(nl.pins(cell).size() == 2);
+	REQUIRE(std::count(nl.pins(cell).begin(), nl.pins(cell).end(), pin2) == 1);
+	REQUIRE(nl.pins(net).size() == 1);
+	nl.connect(net, pin2);
+	REQUIRE(nl.pins(net).size() == 2);
+	REQUIRE(std::count(nl.pins(net).begin(), nl.pins(net).end(), pin2) == 1);
+}
+
 TEST_CASE("Netlist: Add Pin Into Cell.", "[circuit][Netlist]")
 {
 	Netlist nl;
@@ -178,6 +213,20 @@ TEST_CASE("Netlist: Make Cell Property (names)", "[circuit][Netlist]")
 	REQUIRE(names[u2] == "u2");
 }
 
+TEST_CASE("Netlist: Make Cell Sparse Property (don't touch)", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto u1 = nl.add(Cell(), "u1");
+	auto u2 = nl.add(Cell(), "u2");
+	auto dontTouch = nl.makeSparseProperty<bool>(Cell());
+	dontTouch[u2] = true;
+	REQUIRE(dontTouch.size() == 1);
+	REQUIRE(!dontTouch.has(u1));
+	REQUIRE(dontTouch[u2]);
+	nl.erase(u2);
+	REQUIRE(dontTouch.empty());
+}
+
 struct Point2D
 {
 	int x;
@@ -246,6 +295,17 @@ public:
 	{
 		++erased;
 	}
+	void erase(const std::vector<Cell>&) override
+	{
+		// counted in compact()
+	}
+	void compact(const std::vector<bool>& erasedCells) override
+	{
+		erased += std::count(erasedCells.begin(), erasedCells.end(), true);
+	}
+	void permute(const std::vector<uint32_t>&) override
+	{
+	}
 	void clear() override
 	{
 		erased += added;
@@ -330,3 +390,155 @@ TEST_CASE("Netlist: Input Slews & Output Loads", "[circuit][Netlist]")
 	REQUIRE( Approx(inputSlews[nl.input(inp1)]) == 1.1 );
 
 }
+
+TEST_CASE("Netlist: memory usage", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto empty = nl.memoryUsage();
+	REQUIRE( empty.name == "Netlist" );
+
+	auto net = nl.add(Net(), "a_net_with_a_name_longer_than_the_small_string_buffer");
+	for(int i = 0; i < 100; ++i)
+	{
+		auto cell = nl.add(Cell(), "cell" + std::to_string(i));
+		auto pin = nl.add(Pin(), "cell" + std::to_string(i) + ":pin");
+		nl.add(cell, pin);
+		nl.connect(net, pin);
+	}
+	auto usage = nl.memoryUsage();
+	REQUIRE( usage.totalBytes() > empty.totalBytes() );
+
+	auto child = [&usage](const std::string & name) {
+		return *std::find_if(usage.children.begin(), usage.children.end(), [&name](const ophidian::util::MemoryUsage & c) {
+			return c.name == name;
+		});
+	};
+	REQUIRE( child("cells").size == 100 );
+	REQUIRE( child("pins").size == 100 );
+	REQUIRE( child("cellNames").size == 100 );
+	REQUIRE( child("namePool").size == 201 );
+	REQUIRE( child("namePool").totalBytes() > 50 );
+	REQUIRE( child("netPins").totalBytes() > 0 );
+}
+
+TEST_CASE("Netlist: names of erased entities", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto u1 = nl.add(Cell(), "u1");
+	auto u2 = nl.add(Cell(), "u2");
+	auto u1a = nl.add(Pin(), "u1:a");
+	nl.add(u1, u1a);
+	nl.erase(u1);
+	REQUIRE( nl.find(Cell(), "u1") == Cell() );
+	REQUIRE( nl.find(Pin(), "u1:a") == Pin() );
+	REQUIRE( nl.find(Cell(), "u2") == u2 );
+	auto again = nl.add(Cell(), "u1");
+	REQUIRE( again != u1 );
+	REQUIRE( nl.find(Cell(), "u1") == again );
+	REQUIRE( nl.name(again) == "u1" );
+}
+
+TEST_CASE("Netlist: finding missing names", "[circuit][Netlist]")
+{
+	ophidian::util::StringPool names;
+	Netlist nl(ophidian::util::defaultResource(), &names);
+	auto u1 = nl.add(Cell(), "u1");
+	auto u1a = nl.add(Pin(), "u1:a");
+	const Netlist & constNetlist = nl;
+	REQUIRE( constNetlist.find(Cell(), "u2") == Cell() );
+	REQUIRE( constNetlist.find(Pin(), "u1:o") == Pin() );
+	REQUIRE( constNetlist.find(Net(), "u1") == Net() );
+	REQUIRE( names.size() == 2 );
+	REQUIRE( nl.size(Cell()) == 1 );
+
+	std::string line = "u1:a u1";
+	ophidian::util::StringView view(line);
+	REQUIRE( constNetlist.find(Pin(), view.substr(0, 4)) == u1a );
+	REQUIRE( constNetlist.find(Cell(), view.substr(5)) == u1 );
+	REQUIRE( nl.add(Cell(), view.substr(5)) == u1 );
+	REQUIRE( names.size() == 2 );
+}
+
+TEST_CASE("Netlist: frozen names", "[circuit][Netlist]")
+{
+	Netlist nl;
+	std::vector<std::string> pinNames;
+	for(int i = 0; i < 1000; ++i)
+	{
+		pinNames.push_back("u" + std::to_string(i) + ":a");
+	}
+	auto pins = nl.add(Pin(), pinNames);
+	nl.freezeNames();
+	REQUIRE( nl.find(Pin(), "u500:a") == pins[500] );
+	REQUIRE( nl.find(Pin(), "u1000:a") == Pin() );
+	auto late = nl.add(Pin(), "u1000:a");
+	REQUIRE( nl.add(Pin(), "u0:a") == pins[0] );
+	REQUIRE( nl.find(Pin(), "u1000:a") == late );
+	REQUIRE( nl.size(Pin()) == 1001 );
+}
+
+TEST_CASE("Netlist: shared name pool", "[circuit][Netlist]")
+{
+	ophidian::util::StringPool names;
+	Netlist nl(ophidian::util::defaultResource(), &names);
+	auto n1 = nl.add(Net(), "n1");
+	auto u1 = nl.add(Cell(), "n1");
+	nl.add(Pin(), std::vector<std::string>{"u1:a", "u1:o", "u1:a"});
+	REQUIRE( names.size() == 3 );
+	REQUIRE( names.find("u1:o") != ophidian::util::kInvalidSymbol );
+	REQUIRE( nl.find(Net(), "n1") == n1 );
+	REQUIRE( nl.find(Cell(), "n1") == u1 );
+	REQUIRE( nl.size(Pin()) == 2 );
+
+	auto usage = nl.memoryUsage();
+	REQUIRE( std::none_of(usage.children.begin(), usage.children.end(), [](const ophidian::util::MemoryUsage & child) {
+		return child.name == "namePool";
+	}) );
+}
+
+TEST_CASE("Netlist: save and load", "[circuit][Netlist]")
+{
+	Netlist nl;
+	auto u1 = nl.add(Cell(), "u1");
+	auto u1a = nl.add(Pin(), "u1:a");
+	auto u1o = nl.add(Pin(), "u1:o");
+	auto in = nl.add(Pin(), "in");
+	auto n1 = nl.add(Net(), "n1");
+	nl.add(u1, u1a);
+	nl.add(u1, u1o);
+	nl.connect(n1, in);
+	nl.connect(n1, u1a);
+	auto input = nl.add(Input(), in);
+	auto loads = nl.makeProperty<double>(Pin());
+	loads[u1a] = 1.5;
+
+	std::stringstream stream;
+	nl.save(stream);
+	ophidian::util::BinaryWriter writer(stream);
+	loads.save(writer);
+
+	Netlist loaded;
+	auto loadedLoads = loaded.makeProperty<double>(Pin());
+	loaded.add(Cell(), "stale");
+	loaded.load(stream);
+	ophidian::util::BinaryReader reader(stream);
+	loadedLoads.load(reader);
+
+	REQUIRE( loaded.size(Cell()) == 1 );
+	REQUIRE( loaded.size(Pin()) == 3 );
+	REQUIRE( loaded.find(Cell(), "stale") == Cell() );
+	REQUIRE( loaded.find(Cell(), "u1") == u1 );
+	REQUIRE( loaded.find(Pin(), "u1:o") == u1o );
+	REQUIRE( loaded.name(n1) == "n1" );
+	REQUIRE( loaded.cell(u1a) == u1 );
+	REQUIRE( loaded.net(in) == n1 );
+	REQUIRE( loaded.pins(n1).size() == 2 );
+	REQUIRE( loaded.pins(u1).size() == 2 );
+	REQUIRE( loaded.input(in) == input );
+	REQUIRE( loaded.pin(input) == in );
+	REQUIRE( loadedLoads[u1a] == 1.5 );
+
+	loaded.erase(u1);
+	REQUIRE( loaded.size(Pin()) == 1 );
+	REQUIRE( loaded.pins(n1).size() == 1 );
+}
@@ -0,0 +1,155 @@
+#include "netlist_builder.h"
+#include <catch.hpp>
+#include <string>
+#include <vector>
+
+#include <ophidian/circuit/Partitioning.h>
+
+using namespace ophidian::circuit;
+
+namespace
+{
+const std::size_t side = 40;
+
+//! A side x side grid of Cells, with a Net between each pair of neighbors
+class GridFixture
+{
+public:
+    GridFixture() :
+        builder(side * side)
+    {
+        for(std::size_t row = 0; row < side; ++row)
+        {
+            for(std::size_t column = 0; column < side; ++column)
+            {
+                auto cell = row * side + column;
+                if(column + 1 < side)
+                {
+                    builder.connect({cell, cell + 1});
+                }
+                if(row + 1 < side)
+                {
+                    builder.connect({cell, cell + side});
+                }
+            }
+        }
+    }
+
+    NetlistBuilder builder;
+};
+
+bool balanced(const Partition & partition, double total, std::uint32_t parts, double imbalance)
+{
+    for(auto weight : partition.weights)
+    {
+        if(weight > (1.0 + imbalance) * total / parts + 1e-9)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("Partitioning: evaluating a partition", "[circuit][Partitioning]")
+{
+    NetlistBuilder builder(4);
+    builder.connect({0, 1});
+    builder.connect({1, 2, 3});
+    builder.connect({0, 3});
+    Hypergraph hypergraph(builder.netlist);
+    Partition partition;
+    partition.parts = {0, 0, 1, 2};
+    evaluate(hypergraph, {1.0, 2.0, 3.0, 4.0}, partition, 3);
+    REQUIRE( partition.weights == std::vector<double>({3.0, 3.0, 4.0}) );
+    REQUIRE( partition.cut == 2 );
+    REQUIRE( partition.connectivity == 3 );
+}
+
+TEST_CASE("Partitioning: two cliques joined by a net", "[circuit][Partitioning]")
+{
+    NetlistBuilder builder(16);
+    for(std::size_t clique = 0; clique < 2; ++clique)
+    {
+        for(std::size_t a = 0; a < 8; ++a)
+        {
+            for(std::size_t b = a + 1; b < 8; ++b)
+            {
+                builder.connect({clique * 8 + a, clique * 8 + b});
+            }
+        }
+    }
+    builder.connect({7, 8});
+    Hypergraph hypergraph(builder.netlist);
+    auto partition = ophidian::circuit::partition(hypergraph, {}, PartitionOptions(2, 0.0));
+    REQUIRE( partition.cut == 1 );
+    REQUIRE( partition.connectivity == 1 );
+    REQUIRE( partition.weights == std::vector<double>({8.0, 8.0}) );
+    for(std::size_t cell = 0; cell < 8; ++cell)
+    {
+        REQUIRE( partition.parts[hypergraph.index(builder.cells[cell])] == partition.parts[hypergraph.index(builder.cells[0])] );
+        REQUIRE( partition.parts[hypergraph.index(builder.cells[cell + 8])] != partition.parts[hypergraph.index(builder.cells[0])] );
+    }
+}
+
+TEST_CASE_METHOD(GridFixture, "Partitioning: bisecting a grid", "[circuit][Partitioning]")
+{
+    Hypergraph hypergraph(builder.netlist);
+    auto partition = ophidian::circuit::partition(hypergraph, {}, PartitionOptions(2, 0.03));
+    REQUIRE( partition.parts.size() == side * side );
+    REQUIRE( balanced(partition, side * side, 2, 0.03) );
+    REQUIRE( partition.cut >= side );
+    REQUIRE( partition.cut <= 3 * side / 2 );
+    Partition evaluated;
+    evaluated.parts = partition.parts;
+    evaluate(hypergraph, {}, evaluated, 2);
+    REQUIRE( evaluated.cut == partition.cut );
+    REQUIRE( evaluated.weights == partition.weights );
+    evaluate(hypergraph, {}, evaluated, 2, ophidian::entity_system::ParallelOptions(16, 4));
+    REQUIRE( evaluated.cut == partition.cut );
+    REQUIRE( evaluated.connectivity == partition.connectivity );
+}
+
+TEST_CASE_METHOD(GridFixture, "Partitioning: k-way partition of a grid", "[circuit][Partitioning]")
+{
+    Hypergraph hypergraph(builder.netlist);
+    PartitionOptions options(5, 0.05);
+    auto partition = ophidian::circuit::partition(hypergraph, {}, options);
+    REQUIRE( partition.weights.size() == 5 );
+    REQUIRE( balanced(partition, side * side, 5, 0.05) );
+    for(auto weight : partition.weights)
+    {
+        REQUIRE( weight > 0.0 );
+    }
+    REQUIRE( partition.connectivity >= partition.cut );
+    REQUIRE( partition.cut <= 4 * side );
+}
+
+TEST_CASE_METHOD(GridFixture, "Partitioning: weighted cells", "[circuit][Partitioning]")
+{
+    Hypergraph hypergraph(builder.netlist);
+    // the left half of the grid is three times heavier than the right one
+    std::vector<double> weights(hypergraph.size(Cell()));
+    for(std::size_t position = 0; position < builder.cells.size(); ++position)
+    {
+        weights[hypergraph.index(builder.cells[position])] = position % side < side / 2 ? 3.0 : 1.0;
+    }
+    auto partition = ophidian::circuit::partition(hypergraph, weights, PartitionOptions(2, 0.03));
+    const double total = side * side * 2.0;
+    REQUIRE( balanced(partition, total, 2, 0.03) );
+    REQUIRE( partition.weights[0] + partition.weights[1] == total );
+}
+
+TEST_CASE_METHOD(GridFixture, "Partitioning: the result does not depend on the number of threads", "[circuit][Partitioning]")
+{
+    Hypergraph hypergraph(builder.netlist);
+    PartitionOptions serial(4);
+    serial.seed = 7;
+    serial.parallel = ophidian::entity_system::ParallelOptions(32, 1);
+    PartitionOptions parallel = serial;
+    parallel.parallel = ophidian::entity_system::ParallelOptions(32, 4);
+    auto first = ophidian::circuit::partition(hypergraph, {}, serial);
+    auto second = ophidian::circuit::partition(hypergraph, {}, parallel);
+    REQUIRE( first.parts == second.parts );
+    REQUIRE( first.cut == second.cut );
+}
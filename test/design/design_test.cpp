@@ -71,3 +71,66 @@ TEST_CASE("Design: testing library (setting geometry of cells).", "[design]")
 
 }
 
+
+TEST_CASE("Design: huge page backed design.", "[design]")
+{
+	Design hugeDesign(Design::Memory::HugePages);
+	std::vector<std::string> names;
+	for(int i = 0; i < 100000; ++i)
+	{
+		names.push_back("cell" + std::to_string(i));
+	}
+	auto cells = hugeDesign.netlist().add(ophidian::circuit::Cell(), names);
+	hugeDesign.placement().placeCell(cells.back(), ophidian::util::LocationDbu(10, 20));
+	REQUIRE(hugeDesign.netlist().size(ophidian::circuit::Cell()) == 100000);
+	REQUIRE(hugeDesign.placement().cellLocation(cells.back()) == ophidian::util::LocationDbu(10, 20));
+}
+
+TEST_CASE("Design: memory usage.", "[design]")
+{
+	Design design;
+	std::vector<std::string> names;
+	for(int i = 0; i < 1000; ++i)
+	{
+		names.push_back("cell" + std::to_string(i));
+	}
+	design.netlist().add(ophidian::circuit::Cell(), names);
+	auto usage = design.memoryUsage();
+	REQUIRE( usage.children.size() == 7 );
+	REQUIRE( usage.children[0].name == "netlist" );
+	REQUIRE( usage.children[0].totalBytes() >= 1000 * sizeof(ophidian::circuit::Cell) );
+	REQUIRE( usage.totalBytes() >= usage.children[0].totalBytes() + usage.children[2].totalBytes() );
+}
+
+TEST_CASE("Design: arena backed design.", "[design]")
+{
+	Design heapDesign;
+	REQUIRE( heapDesign.resource() == ophidian::util::defaultResource() );
+
+	Design arenaDesign(Design::Memory::Arena);
+	REQUIRE( arenaDesign.resource() != ophidian::util::defaultResource() );
+	std::vector<std::string> names;
+	for(int i = 0; i < 1000; ++i)
+	{
+		names.push_back("cell" + std::to_string(i));
+	}
+	arenaDesign.netlist().add(ophidian::circuit::Cell(), names);
+	REQUIRE( arenaDesign.netlist().size(ophidian::circuit::Cell()) == 1000 );
+	auto usage = arenaDesign.memoryUsage();
+	REQUIRE( usage.children.size() == 8 );
+	REQUIRE( usage.children.back().name == "arena" );
+	REQUIRE( usage.children.back().size >= 1000 * sizeof(ophidian::circuit::Cell) );
+}
+
+TEST_CASE("Design: names are interned once.", "[design]")
+{
+	Design design;
+	auto cell = design.netlist().add(ophidian::circuit::Cell(), "INV_X1");
+	auto stdCell = design.standardCells().add(ophidian::standard_cell::Cell(), "INV_X1");
+	auto site = design.floorplan().add(ophidian::floorplan::Site(), "core", ophidian::util::LocationDbu(1, 1));
+	design.netlist().add(ophidian::circuit::Net(), "core");
+	REQUIRE( design.names().size() == 2 );
+	REQUIRE( design.netlist().name(cell) == "INV_X1" );
+	REQUIRE( design.standardCells().name(stdCell) == "INV_X1" );
+	REQUIRE( design.floorplan().find("core") == site );
+}
@@ -0,0 +1,55 @@
+#include <catch.hpp>
+#include <chrono>
+#include <iostream>
+
+#include <ophidian/design/DesignBuilder.h>
+#include <ophidian/placement/Partitioning.h>
+
+using namespace ophidian;
+
+namespace
+{
+void profilePartitioning(design::Design & design, const std::string & name)
+{
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    circuit::Hypergraph hypergraph(design.netlist());
+    auto areas = placement::cellAreas(hypergraph, design.library(), design.libraryMapping());
+    auto built = Clock::now();
+    std::cout << name << ": " << hypergraph.size(circuit::Cell()) << " cells, " << hypergraph.size(circuit::Net()) << " nets, "
+              << std::chrono::duration<double>(built - start).count() << " s to build the hypergraph" << std::endl;
+    for(std::uint32_t parts : {2u, 8u})
+    {
+        circuit::PartitionOptions options(parts, 0.05);
+        start = Clock::now();
+        auto partition = circuit::partition(hypergraph, areas, options);
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << name << ": " << parts << "-way cut " << partition.cut << ", connectivity " << partition.connectivity << ", " << elapsed << " s" << std::endl;
+        double total = 0.0;
+        for(auto weight : partition.weights)
+        {
+            total += weight;
+        }
+        for(auto weight : partition.weights)
+        {
+            REQUIRE( weight <= 1.05 * total / parts * 1.001 );
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Partitioning: ICCAD 2017 design", "[design][Partitioning][Profiling]")
+{
+    design::ICCAD2017ContestDesignBuilder builder("./input_files/pci_bridge32_a_md1/cells_modified.lef",
+                                                  "./input_files/pci_bridge32_a_md1/tech.lef",
+                                                  "./input_files/pci_bridge32_a_md1/placed.def");
+    profilePartitioning(builder.build(), "pci_bridge32_a_md1");
+}
+
+TEST_CASE("Partitioning: superblue18", "[design][Partitioning][Profiling]")
+{
+    design::ICCAD2015ContestDesignBuilder builder("./input_files/superblue18/superblue18.lef",
+                                                  "./input_files/superblue18/superblue18.def",
+                                                  "./input_files/superblue18/superblue18.v");
+    profilePartitioning(builder.build(), "superblue18");
+}
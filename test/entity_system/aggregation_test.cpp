@@ -1,5 +1,6 @@
 #include "aggregation_test.h"
 #include <catch.hpp>
+#include <algorithm>
 
 #include <ophidian/entity_system/Aggregation.h>
 
@@ -101,6 +102,40 @@ TEST_CASE("Aggregation: add parts, erase one, keep others", "[entity_system][Pro
 }
 
 
+TEST_CASE("Aggregation: erase associations anywhere in the list", "[entity_system][Property][Aggregation][EntitySystem]")
+{
+    EntitySystem<EntityA> sys1;
+    EntitySystem<EntityB> sys2;
+    Aggregation<EntityA, EntityB> aggregation(sys1, sys2);
+    auto en1 = sys1.add();
+    auto en2 = sys1.add();
+    std::vector<EntityB> parts{ sys2.add(), sys2.add(), sys2.add(), sys2.add(), sys2.add() };
+    for(auto const & part : parts)
+    {
+        aggregation.addAssociation(en1, part);
+    }
+
+    INFO("Erase from the middle, the head and the tail");
+    aggregation.eraseAssociation(en1, parts[2]);
+    aggregation.eraseAssociation(en1, parts[4]);
+    aggregation.eraseAssociation(en1, parts[0]);
+    REQUIRE(aggregation.numParts(en1) == 2);
+    std::vector<EntityB> remaining(aggregation.parts(en1).begin(), aggregation.parts(en1).end());
+    REQUIRE(remaining == std::vector<EntityB>({ parts[3], parts[1] }));
+
+    INFO("Detached parts can be associated to another whole without stale links");
+    aggregation.addAssociation(en2, parts[2]);
+    aggregation.addAssociation(en2, parts[0]);
+    REQUIRE(aggregation.numParts(en2) == 2);
+    std::vector<EntityB> moved(aggregation.parts(en2).begin(), aggregation.parts(en2).end());
+    REQUIRE(moved == std::vector<EntityB>({ parts[0], parts[2] }));
+
+    aggregation.eraseAssociation(en1, parts[3]);
+    aggregation.eraseAssociation(en1, parts[1]);
+    REQUIRE(aggregation.parts(en1).empty());
+    REQUIRE(aggregation.firstPart(en1) == EntityB());
+}
+
 TEST_CASE("Aggregation: clear()", "[entity_system][Property][Aggregation][EntitySystem]")
 {
     INFO("Given an aggregation with 5 wholes and some parts");
@@ -173,3 +208,66 @@ TEST_CASE("Aggregation: lifetime managment", "[entity_system][Property][Aggregat
 
     REQUIRE_NOTHROW(sys1.add());
 }
+
+TEST_CASE("Aggregation: erase many parts", "[entity_system][Property][Aggregation][EntitySystem]")
+{
+    EntitySystem<EntityA> sys1;
+    EntitySystem<EntityB> sys2;
+    Aggregation<EntityA, EntityB> aggregation(sys1, sys2);
+    auto en1 = sys1.add();
+    auto en2 = sys1.add();
+    std::vector<EntityB> parts{ sys2.add(), sys2.add(), sys2.add(), sys2.add(), sys2.add() };
+    for(auto const & part : parts)
+    {
+        aggregation.addAssociation(parts.size() % 2 ? en1 : en2, part);
+    }
+    aggregation.eraseAssociation(en1, parts[4]);
+    aggregation.addAssociation(en2, parts[4]);
+    sys2.erase(std::vector<EntityB>{parts[0], parts[4]});
+    REQUIRE(sys2.size() == 3);
+    REQUIRE(aggregation.parts(en1).size() == 3);
+    REQUIRE(aggregation.parts(en2).size() == 0);
+    for(auto i : {1, 2, 3})
+    {
+        REQUIRE(aggregation.whole(parts[i]) == en1);
+        auto wholeParts = aggregation.parts(en1);
+        REQUIRE(std::count(wholeParts.begin(), wholeParts.end(), parts[i]) == 1);
+    }
+    sys1.erase(std::vector<EntityA>{en1, en2});
+    REQUIRE(sys1.empty());
+    REQUIRE(sys2.size() == 3);
+    REQUIRE(aggregation.whole(parts[1]) == EntityA());
+}
+
+TEST_CASE("Aggregation: freeze", "[entity_system][Property][Aggregation][EntitySystem]")
+{
+    EntitySystem<EntityA> sys1;
+    EntitySystem<EntityB> sys2;
+    Aggregation<EntityA, EntityB> aggregation(sys1, sys2);
+    auto en1 = sys1.add();
+    auto en2 = sys1.add();
+    auto en3 = sys1.add();
+    std::vector<EntityB> parts{ sys2.add(), sys2.add(), sys2.add(), sys2.add() };
+    aggregation.addAssociation(en1, parts[0]);
+    aggregation.addAssociation(en3, parts[1]);
+    aggregation.addAssociation(en1, parts[2]);
+
+    auto linkedParts = aggregation.parts(en1);
+    std::vector<EntityB> expected(linkedParts.begin(), linkedParts.end());
+    aggregation.freeze();
+    REQUIRE(aggregation.frozen());
+    auto frozenParts = aggregation.parts(en1);
+    REQUIRE(std::vector<EntityB>(frozenParts.begin(), frozenParts.end()) == expected);
+    REQUIRE(aggregation.parts(en2).begin() == aggregation.parts(en2).end());
+    REQUIRE(std::count(aggregation.parts(en3).begin(), aggregation.parts(en3).end(), parts[1]) == 1);
+
+    INFO("Changing the association invalidates the snapshot");
+    aggregation.addAssociation(en2, parts[3]);
+    REQUIRE(!aggregation.frozen());
+    REQUIRE(std::count(aggregation.parts(en2).begin(), aggregation.parts(en2).end(), parts[3]) == 1);
+
+    aggregation.freeze();
+    sys1.erase(en1);
+    REQUIRE(!aggregation.frozen());
+    REQUIRE(std::count(aggregation.parts(en3).begin(), aggregation.parts(en3).end(), parts[1]) == 1);
+}
@@ -0,0 +1,84 @@
+#include "property_test.h"
+#include <catch.hpp>
+#include <string>
+
+#include <ophidian/entity_system/Archetype.h>
+
+using namespace ophidian::entity_system;
+
+namespace
+{
+enum Fields
+{
+    NAME, WEIGHT, DEGREE
+};
+using MyArchetype = Archetype<MyEntity, std::string, double, int>;
+}
+
+TEST_CASE("Archetype: components follow the Entities", "[entity_system][Archetype]")
+{
+    MyArchetype archetype;
+    REQUIRE( archetype.empty() );
+    auto en1 = archetype.emplace("a", 1.0, 1);
+    auto en2 = archetype.emplace("b", 2.0, 2);
+    auto en3 = archetype.add();
+    archetype.get<NAME>(en3) = "c";
+    archetype.get<WEIGHT>(en3) = 3.0;
+    REQUIRE( archetype.size() == 3 );
+    REQUIRE( archetype.get<DEGREE>(en3) == 0 );
+    REQUIRE( archetype.get<NAME>(en2) == "b" );
+    REQUIRE( archetype.data<WEIGHT>()[archetype.system().id(en1)] == 1.0 );
+
+    archetype.erase(en1);
+    REQUIRE( archetype.size() == 2 );
+    REQUIRE( !archetype.valid(en1) );
+    REQUIRE( archetype.get<NAME>(en2) == "b" );
+    REQUIRE( archetype.get<NAME>(en3) == "c" );
+    REQUIRE( archetype.get<WEIGHT>(en3) == 3.0 );
+
+    auto added = archetype.add(10);
+    REQUIRE( archetype.size() == 12 );
+    std::vector<MyEntity> toErase(added.begin(), added.end());
+    toErase.push_back(en2);
+    archetype.erase(toErase);
+    REQUIRE( archetype.size() == 1 );
+    REQUIRE( archetype.get<NAME>(en3) == "c" );
+
+    archetype.clear();
+    REQUIRE( archetype.empty() );
+}
+
+TEST_CASE("Archetype: permute and runtime properties", "[entity_system][Archetype]")
+{
+    MyArchetype archetype;
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 5; ++i)
+    {
+        entities.push_back(archetype.emplace(std::to_string(i), i * 0.5, i));
+    }
+    auto extra = archetype.makeProperty<int>();
+    for(int i = 0; i < 5; ++i)
+    {
+        extra[entities[i]] = 10 * i;
+    }
+
+    archetype.permute({4, 3, 2, 1, 0});
+    REQUIRE( *archetype.begin() == entities[4] );
+    for(int i = 0; i < 5; ++i)
+    {
+        REQUIRE( archetype.get<NAME>(entities[i]) == std::to_string(i) );
+        REQUIRE( archetype.get<DEGREE>(entities[i]) == i );
+        REQUIRE( extra[entities[i]] == 10 * i );
+    }
+    REQUIRE( archetype.data<DEGREE>()[0] == 4 );
+
+    archetype.erase(entities[1]);
+    REQUIRE( extra.size() == 4 );
+    REQUIRE( archetype.get<DEGREE>(entities[0]) == 0 );
+    REQUIRE( extra[entities[0]] == 0 );
+
+    auto usage = archetype.memoryUsage();
+    REQUIRE( usage.children.size() == 4 );
+    REQUIRE( usage.children[3].name == "component2" );
+    REQUIRE( usage.children[3].size == 4 );
+}
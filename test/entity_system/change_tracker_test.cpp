@@ -0,0 +1,69 @@
+#include "property_test.h"
+#include <catch.hpp>
+
+#include <ophidian/entity_system/ChangeTracker.h>
+
+using namespace ophidian::entity_system;
+
+TEST_CASE("ChangeTracker: nothing is recorded without consumers", "[entity_system][ChangeTracker]")
+{
+    EntitySystem<MyEntity> sys;
+    ChangeTracker<MyEntity> tracker(sys);
+    auto en1 = sys.add();
+    tracker.touch(en1);
+    auto consumer = tracker.subscribe();
+    REQUIRE( !tracker.pending(consumer) );
+    REQUIRE( tracker.drain(consumer).empty() );
+}
+
+TEST_CASE("ChangeTracker: consumers drain independently", "[entity_system][ChangeTracker]")
+{
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, int> prop(sys);
+    ChangeTracker<MyEntity> tracker(sys);
+    prop.trackChanges(&tracker);
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    auto en3 = sys.add();
+
+    auto first = tracker.subscribe();
+    prop.set(en1, 1);
+    prop.set(en2, 2);
+    prop.set(en1, 10);
+
+    auto second = tracker.subscribe();
+    prop.set(en3, 3);
+    prop.set(en1, 100);
+
+    REQUIRE( tracker.drain(first) == std::vector<MyEntity>({en2, en3, en1}) );
+    REQUIRE( !tracker.pending(first) );
+
+    prop.set(en2, 20);
+    REQUIRE( tracker.drain(second) == std::vector<MyEntity>({en3, en1, en2}) );
+    REQUIRE( tracker.drain(first) == std::vector<MyEntity>({en2}) );
+
+    INFO("Erased entities are dropped");
+    prop.set(en3, 30);
+    sys.erase(en3);
+    REQUIRE( tracker.drain(first).empty() );
+
+    INFO("Rollback reports the restored entities");
+    prop.checkpoint();
+    prop.set(en1, 1000);
+    tracker.drain(first);
+    prop.rollback();
+    REQUIRE( tracker.drain(first) == std::vector<MyEntity>({en1}) );
+    const Property<MyEntity, int> & constProp = prop;
+    REQUIRE( constProp[en1] == 100 );
+    REQUIRE( !tracker.pending(first) );
+
+    INFO("Reads and plain writes are not reported");
+    REQUIRE( prop[en1] == 100 );
+    prop[en2] = 200;
+    REQUIRE( !tracker.pending(first) );
+
+    tracker.unsubscribe(second);
+    prop.trackChanges(nullptr);
+    prop.set(en2, 0);
+    REQUIRE( !tracker.pending(first) );
+}
@@ -1,10 +1,11 @@
 #include "composition_test.h"
 #include <catch.hpp>
+#include <algorithm>
 
 using namespace ophidian::entity_system;
 
-PartEntity::PartEntity(uint32_t id, EntitySystemBase *system) :
-    EntityBase(id, system)
+PartEntity::PartEntity(uint32_t id, uint32_t generation) :
+    EntityBase(id, generation)
 {
 
 }
@@ -15,8 +16,8 @@ PartEntity::PartEntity() :
 
 }
 
-WholeEntity::WholeEntity(uint32_t id, EntitySystemBase *system) :
-    EntityBase(id, system)
+WholeEntity::WholeEntity(uint32_t id, uint32_t generation) :
+    EntityBase(id, generation)
 {
 
 }
@@ -170,3 +171,121 @@ TEST_CASE("Composition: self composition clear", "[entity_system][Property][Comp
 
 
 
+
+TEST_CASE("Composition: erase many wholes, erase their parts", "[entity_system][Property][Composition][EntitySystem]")
+{
+    WholeSystem wholes;
+    PartSystem parts;
+    SimpleComposition compo(wholes, parts);
+    auto w1 = wholes.add();
+    auto w2 = wholes.add();
+    auto w3 = wholes.add();
+    auto p1 = parts.add();
+    auto p2 = parts.add();
+    auto p3 = parts.add();
+    auto p4 = parts.add();
+    compo.addAssociation(w1, p1);
+    compo.addAssociation(w1, p2);
+    compo.addAssociation(w2, p3);
+    compo.addAssociation(w3, p4);
+    wholes.erase(std::vector<WholeEntity>{w1, w3});
+    REQUIRE( wholes.size() == 1 );
+    REQUIRE( parts.size() == 1 );
+    REQUIRE( parts.valid(p3) );
+    REQUIRE( compo.whole(p3) == w2 );
+    REQUIRE( compo.parts(w2).size() == 1 );
+    REQUIRE( *compo.parts(w2).begin() == p3 );
+}
+
+namespace
+{
+//! Records the parts erased one by one and in bulk
+class ErasedPartsObserver : public PartSystem::NotifierType::ObserverBase
+{
+public:
+    ErasedPartsObserver(const PartSystem & parts) :
+        PartSystem::NotifierType::ObserverBase(*parts.notifier())
+    {
+
+    }
+
+    void add(const PartEntity &) override
+    {
+    }
+    void add(const std::vector<PartEntity> &) override
+    {
+    }
+    void erase(const PartEntity & item) override
+    {
+        erased.push_back(item);
+    }
+    void erase(const std::vector<PartEntity> & items) override
+    {
+        erased.insert(erased.end(), items.begin(), items.end());
+    }
+    void compact(const std::vector<bool> & flags) override
+    {
+        compacted += std::count(flags.begin(), flags.end(), true);
+    }
+    void permute(const std::vector<uint32_t> &) override
+    {
+    }
+    void clear() override
+    {
+    }
+    void reserve(uint32_t) override
+    {
+    }
+    void shrinkToFit() override
+    {
+    }
+
+    std::vector<PartEntity> erased;
+    std::size_t compacted = 0;
+};
+} // namespace
+
+TEST_CASE("Composition: clearing the wholes reports the erased parts to the part observers", "[entity_system][Property][Composition][EntitySystem]")
+{
+    WholeSystem wholes;
+    PartSystem parts;
+    SimpleComposition compo(wholes, parts);
+    Property<PartEntity, int> values(parts, 0);
+    ErasedPartsObserver observer(parts);
+    auto w1 = wholes.add();
+    auto w2 = wholes.add();
+    auto p1 = parts.add();
+    auto p2 = parts.add();
+    auto unassigned = parts.add();
+    auto p3 = parts.add();
+    compo.addAssociation(w1, p1);
+    compo.addAssociation(w1, p2);
+    compo.addAssociation(w2, p3);
+    values[p1] = 1;
+    values[p2] = 2;
+    values[unassigned] = 3;
+    values[p3] = 4;
+    wholes.clear();
+    REQUIRE( parts.size() == 1 );
+    REQUIRE( parts.valid(unassigned) );
+    REQUIRE( values[unassigned] == 3 );
+    REQUIRE( observer.erased.size() == 3 );
+    REQUIRE( std::is_permutation(observer.erased.begin(), observer.erased.end(), std::vector<PartEntity>{p1, p2, p3}.begin()) );
+    REQUIRE( observer.compacted == 3 );
+}
+
+TEST_CASE("Composition: self composition erase many", "[entity_system][Property][Composition][EntitySystem]")
+{
+    EntitySystem<WholeEntity> sys;
+    Composition<WholeEntity, WholeEntity> compo(sys, sys);
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    auto en3 = sys.add();
+    auto en4 = sys.add();
+    compo.addAssociation(en1, en2);
+    compo.addAssociation(en2, en3);
+    sys.erase(std::vector<WholeEntity>{en1, en3});
+    REQUIRE( sys.size() == 1 );
+    REQUIRE( sys.valid(en4) );
+    REQUIRE( !sys.valid(en2) );
+}
@@ -7,13 +7,13 @@
 
 class PartEntity : public ophidian::entity_system::EntityBase {
 public:
-    PartEntity(uint32_t id, ophidian::entity_system::EntitySystemBase * system);
+    PartEntity(uint32_t id, uint32_t generation);
     PartEntity();
 };
 
 class WholeEntity : public ophidian::entity_system::EntityBase {
 public:
-    WholeEntity(uint32_t id, ophidian::entity_system::EntitySystemBase * system);
+    WholeEntity(uint32_t id, uint32_t generation);
     WholeEntity();
 };
 
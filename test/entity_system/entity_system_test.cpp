@@ -70,3 +70,134 @@ TEST_CASE("EntitySystem: shrink", "[entity_system][EntitySystem]") {
     sys.shrinkToFit();
     REQUIRE( sys.capacity() == 3 );
 }
+
+TEST_CASE("EntitySystem: handle size", "[entity_system][EntitySystem]") {
+    REQUIRE( sizeof(Entity) == 2*sizeof(uint32_t) );
+}
+
+TEST_CASE("EntitySystem: stale handle", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    auto entity1 = sys.add();
+    auto entity2 = sys.add();
+    sys.erase(entity1);
+    REQUIRE( !sys.valid(entity1) );
+    REQUIRE( sys.valid(entity2) );
+    REQUIRE( sys.id(entity2) == 0 );
+    REQUIRE( !sys.valid(Entity()) );
+}
+
+TEST_CASE("EntitySystem: clear invalidates handles", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    auto entity1 = sys.add();
+    auto entity2 = sys.add();
+    sys.clear();
+    REQUIRE( !sys.valid(entity1) );
+    REQUIRE( !sys.valid(entity2) );
+    auto entity3 = sys.add();
+    REQUIRE( sys.valid(entity3) );
+    REQUIRE( entity3 != entity1 );
+    REQUIRE( entity3 != entity2 );
+}
+
+TEST_CASE("EntitySystem: recycle ids", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    auto entity1 = sys.add();
+    auto entity2 = sys.add();
+    sys.erase(entity1);
+    auto entity3 = sys.add();
+    REQUIRE( sys.size() == 2 );
+    REQUIRE( !sys.valid(entity1) );
+    REQUIRE( sys.valid(entity2) );
+    REQUIRE( sys.valid(entity3) );
+    REQUIRE( entity3 != entity1 );
+    REQUIRE( std::count(sys.begin(), sys.end(), entity1) == 0 );
+    REQUIRE( std::count(sys.begin(), sys.end(), entity3) == 1 );
+}
+
+TEST_CASE("EntitySystem: erase and add keeps properties consistent", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    Property<Entity, int> prop(sys, -1);
+    std::vector<Entity> entities;
+    for(int i = 0; i < 10; ++i)
+    {
+        entities.push_back(sys.add());
+        prop[entities.back()] = i;
+    }
+    for(int round = 0; round < 100; ++round)
+    {
+        sys.erase(entities[round % 10]);
+        entities[round % 10] = sys.add();
+        prop[entities[round % 10]] = round % 10;
+    }
+    REQUIRE( sys.size() == 10 );
+    for(int i = 0; i < 10; ++i)
+    {
+        REQUIRE( sys.valid(entities[i]) );
+        REQUIRE( prop[entities[i]] == i );
+    }
+}
+
+TEST_CASE("EntitySystem: add many entities", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    Property<Entity, int> prop(sys, 7);
+    auto entity1 = sys.add();
+    sys.erase(entity1);
+    auto entities = sys.add(3);
+    REQUIRE( entities.size() == 3 );
+    REQUIRE( sys.size() == 3 );
+    REQUIRE( prop.size() == 3 );
+    REQUIRE( std::equal(entities.begin(), entities.end(), sys.begin()) );
+    for(auto const & entity : entities)
+    {
+        REQUIRE( sys.valid(entity) );
+        REQUIRE( prop[entity] == 7 );
+    }
+    REQUIRE( std::count(entities.begin(), entities.end(), entity1) == 0 );
+}
+
+TEST_CASE("EntitySystem: erase many entities", "[entity_system][EntitySystem]") {
+    EntitySystem<Entity> sys;
+    Property<Entity, int> prop(sys);
+    std::vector<Entity> entities;
+    for(int i = 0; i < 10; ++i)
+    {
+        entities.push_back(sys.add());
+        prop[entities.back()] = i;
+    }
+    sys.erase(std::vector<Entity>{entities[7], entities[2], entities[3], entities[2]});
+    REQUIRE( sys.size() == 7 );
+    REQUIRE( prop.size() == 7 );
+    REQUIRE( !sys.valid(entities[2]) );
+    REQUIRE( !sys.valid(entities[3]) );
+    REQUIRE( !sys.valid(entities[7]) );
+    std::vector<int> remaining(prop.begin(), prop.end());
+    REQUIRE( remaining == std::vector<int>({0, 1, 4, 5, 6, 8, 9}) );
+    for(int i : remaining)
+    {
+        REQUIRE( prop[entities[i]] == i );
+        REQUIRE( *(sys.begin() + sys.id(entities[i])) == entities[i] );
+    }
+}
+
+TEST_CASE("EntitySystem: permute entities and properties", "[entity_system][EntitySystem]")
+{
+    EntitySystem<Entity> sys;
+    Property<Entity, int> prop(sys);
+    std::vector<Entity> entities;
+    for(int i = 0; i < 5; ++i)
+    {
+        entities.push_back(sys.add());
+        prop[entities.back()] = i;
+    }
+    sys.permute({4, 2, 0, 1, 3});
+    REQUIRE( std::vector<Entity>(sys.begin(), sys.end()) == std::vector<Entity>({entities[4], entities[2], entities[0], entities[1], entities[3]}) );
+    REQUIRE( std::vector<int>(prop.begin(), prop.end()) == std::vector<int>({4, 2, 0, 1, 3}) );
+    for(int i = 0; i < 5; ++i)
+    {
+        REQUIRE( sys.valid(entities[i]) );
+        REQUIRE( prop[entities[i]] == i );
+    }
+    sys.erase(entities[2]);
+    REQUIRE( prop[entities[4]] == 4 );
+    REQUIRE( prop[entities[3]] == 3 );
+}
@@ -0,0 +1,112 @@
+#include "property_test.h"
+#include <catch.hpp>
+
+#include <ophidian/entity_system/NameIndex.h>
+
+using namespace ophidian::entity_system;
+using ophidian::util::StringPool;
+
+TEST_CASE("NameIndex: finds Entities by name", "[entity_system][NameIndex]")
+{
+    EntitySystem<MyEntity> sys;
+    StringPool pool;
+    NameIndex<MyEntity> names(sys, pool);
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    names.assign(en1, names.intern("en1"));
+    names.assign(en2, names.intern("en2"));
+    REQUIRE( names.find("en1") == en1 );
+    REQUIRE( names.find("en2") == en2 );
+    REQUIRE( names.name(en2) == "en2" );
+    REQUIRE( names.view(en1) == "en1" );
+    REQUIRE( names.find("en3") == MyEntity() );
+    REQUIRE( pool.size() == 2 );
+
+    names.assign(en1, names.intern("renamed"));
+    REQUIRE( names.find("en1") == MyEntity() );
+    REQUIRE( names.find("renamed") == en1 );
+}
+
+TEST_CASE("NameIndex: erased Entities are not found", "[entity_system][NameIndex]")
+{
+    EntitySystem<MyEntity> sys;
+    StringPool pool;
+    NameIndex<MyEntity> names(sys, pool);
+    auto entities = names.add(sys, {"a", "b", "a", "c"});
+    REQUIRE( sys.size() == 3 );
+    REQUIRE( entities[0] == entities[2] );
+    REQUIRE( names.name(entities[3]) == "c" );
+
+    sys.erase(entities[1]);
+    REQUIRE( names.find("b") == MyEntity() );
+    REQUIRE( names.find("c") == entities[3] );
+    std::vector<MyEntity> toErase{entities[0]};
+    sys.erase(toErase);
+    REQUIRE( names.find("a") == MyEntity() );
+
+    auto again = names.add(sys, {"a", "c"});
+    REQUIRE( again[0] != entities[0] );
+    REQUIRE( again[1] == entities[3] );
+    REQUIRE( names.find("a") == again[0] );
+}
+
+TEST_CASE("NameIndex: systems share a pool", "[entity_system][NameIndex]")
+{
+    EntitySystem<MyEntity> cells;
+    EntitySystem<MyEntity> nets;
+    StringPool pool;
+    NameIndex<MyEntity> cellNames(cells, pool);
+    NameIndex<MyEntity> netNames(nets, pool);
+    auto cell = cellNames.add(cells, {"u1"}).front();
+    REQUIRE( netNames.find("u1") == MyEntity() );
+    auto net = netNames.add(nets, {"u1"}).front();
+    REQUIRE( pool.size() == 1 );
+    REQUIRE( cellNames.symbol(cell) == netNames.symbol(net) );
+    REQUIRE( netNames.find("u1") == net );
+}
+
+TEST_CASE("NameIndex: the table only holds the names of its own Entities", "[entity_system][NameIndex]")
+{
+    EntitySystem<MyEntity> cells;
+    EntitySystem<MyEntity> nets;
+    StringPool pool;
+    NameIndex<MyEntity> cellNames(cells, pool);
+    NameIndex<MyEntity> netNames(nets, pool);
+    std::vector<std::string> names;
+    for(int i = 0; i < 10000; ++i)
+    {
+        names.push_back("u" + std::to_string(i));
+    }
+    auto entities = cellNames.add(cells, names);
+    auto net = netNames.add(nets, {"n1"}).front();
+    REQUIRE( netNames.memoryUsage().children[1].bytes < 1024 );
+    REQUIRE( netNames.find("n1") == net );
+    REQUIRE( netNames.find("u1") == MyEntity() );
+
+    INFO("Renaming and erasing keep every other name reachable");
+    for(int i = 0; i < 10000; i += 2)
+    {
+        cellNames.assign(entities[i], cellNames.intern("v" + std::to_string(i)));
+    }
+    std::vector<MyEntity> toErase;
+    for(int i = 1; i < 10000; i += 4)
+    {
+        toErase.push_back(entities[i]);
+    }
+    cells.erase(toErase);
+    for(int i = 0; i < 10000; ++i)
+    {
+        auto renamed = cellNames.find("v" + std::to_string(i));
+        auto original = cellNames.find("u" + std::to_string(i));
+        if(i % 2 == 0)
+        {
+            REQUIRE( renamed == entities[i] );
+            REQUIRE( original == MyEntity() );
+        }
+        else
+        {
+            REQUIRE( renamed == MyEntity() );
+            REQUIRE( original == (i % 4 == 1 ? MyEntity() : entities[i]) );
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include "property_test.h"
+#include <catch.hpp>
+
+#include <ophidian/entity_system/PackedProperty.h>
+
+using namespace ophidian::entity_system;
+
+namespace
+{
+enum class Color
+{
+    RED, GREEN, BLUE
+};
+}
+
+TEST_CASE("PackedProperty: bits are packed 64 per word", "[entity_system][PackedProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    BitProperty<MyEntity> flags(sys);
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 130; ++i)
+    {
+        entities.push_back(sys.add());
+    }
+    REQUIRE( flags.size() == 130 );
+    REQUIRE( flags.words().size() == 3 );
+    REQUIRE( flags.count(false) == 130 );
+
+    for(int i = 0; i < 130; i += 3)
+    {
+        flags[entities[i]] = true;
+    }
+    REQUIRE( flags.count(true) == 44 );
+    REQUIRE( flags.count(false) == 86 );
+    REQUIRE( flags[entities[63]] );
+    REQUIRE( !flags[entities[64]] );
+
+    std::vector<MyEntity> visited;
+    flags.forEach(true, [&visited](const MyEntity & entity) {
+        visited.push_back(entity);
+    });
+    REQUIRE( visited.size() == 44 );
+    for(std::size_t i = 0; i < visited.size(); ++i)
+    {
+        REQUIRE( visited[i] == entities[3 * i] );
+    }
+}
+
+TEST_CASE("PackedProperty: small enumerations", "[entity_system][PackedProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    PackedProperty<MyEntity, Color, 2> colors(sys, Color::BLUE);
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 100; ++i)
+    {
+        entities.push_back(sys.add());
+    }
+    REQUIRE( colors.count(Color::BLUE) == 100 );
+    REQUIRE( colors.count(Color::RED) == 0 );
+    for(int i = 0; i < 100; ++i)
+    {
+        colors[entities[i]] = static_cast<Color>(i % 3);
+    }
+    REQUIRE( colors.count(Color::RED) == 34 );
+    REQUIRE( colors.count(Color::GREEN) == 33 );
+    REQUIRE( colors.count(Color::BLUE) == 33 );
+    const auto & constColors = colors;
+    REQUIRE( constColors[entities[50]] == Color::BLUE );
+
+    std::size_t greens = 0;
+    colors.forEach(Color::GREEN, [&](const MyEntity & entity) {
+        REQUIRE( constColors[entity] == Color::GREEN );
+        ++greens;
+    });
+    REQUIRE( greens == 33 );
+}
+
+TEST_CASE("PackedProperty: follows the EntitySystem lifecycle", "[entity_system][PackedProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    PackedProperty<MyEntity, Color, 2> colors(sys);
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 40; ++i)
+    {
+        entities.push_back(sys.add());
+        colors[entities.back()] = static_cast<Color>(i % 3);
+    }
+
+    sys.erase(entities[0]);
+    REQUIRE( colors.size() == 39 );
+    REQUIRE( colors[entities[39]] == Color::RED );
+    REQUIRE( colors.count(Color::RED) == 13 );
+
+    std::vector<MyEntity> toErase{entities[1], entities[2], entities[3]};
+    sys.erase(toErase);
+    REQUIRE( colors.size() == 36 );
+    REQUIRE( colors.count(Color::RED) == 12 );
+    for(int i = 4; i < 40; ++i)
+    {
+        REQUIRE( colors[entities[i]] == static_cast<Color>(i % 3) );
+    }
+
+    std::vector<uint32_t> order(sys.size());
+    for(uint32_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = order.size() - 1 - i;
+    }
+    sys.permute(order);
+    for(int i = 4; i < 40; ++i)
+    {
+        REQUIRE( colors[entities[i]] == static_cast<Color>(i % 3) );
+    }
+
+    auto en = sys.add();
+    REQUIRE( colors[en] == Color::RED );
+    REQUIRE( colors.count(Color::RED) == 13 );
+
+    sys.clear();
+    REQUIRE( colors.empty() );
+    REQUIRE( colors.count(Color::RED) == 0 );
+}
@@ -0,0 +1,85 @@
+#include "property_test.h"
+#include <catch.hpp>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+#include <ophidian/entity_system/Parallel.h>
+#include <ophidian/entity_system/Property.h>
+
+using namespace ophidian::entity_system;
+
+TEST_CASE("Parallel: chunks cover every entity once", "[entity_system][Parallel]")
+{
+    EntitySystem<MyEntity> sys;
+    sys.add(1000);
+    Property<MyEntity, int> visits(sys, 0);
+    std::atomic<int> chunks(0);
+    std::atomic<int> largeChunks(0);
+    parallel_for_chunks(sys, [&](const ophidian::util::Range<EntitySystem<MyEntity>::const_iterator> & chunk)
+    {
+        if(chunk.size() > 64)
+        {
+            ++largeChunks;
+        }
+        for(auto const & entity : chunk)
+        {
+            ++visits[entity];
+        }
+        ++chunks;
+    }, ParallelOptions(64, 4));
+    REQUIRE( chunks == 16 );
+    REQUIRE( largeChunks == 0 );
+    REQUIRE( std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }) );
+}
+
+TEST_CASE("Parallel: ranges cover every index once", "[entity_system][Parallel]")
+{
+    std::vector<int> visits(1000, 0);
+    std::atomic<int> ranges(0);
+    std::atomic<int> largeRanges(0);
+    parallel_for_range(visits.size(), [&](std::size_t first, std::size_t last)
+    {
+        if(last - first > 64)
+        {
+            ++largeRanges;
+        }
+        for(auto index = first; index < last; ++index)
+        {
+            ++visits[index];
+        }
+        ++ranges;
+    }, ParallelOptions(64, 4));
+    REQUIRE( ranges == 16 );
+    REQUIRE( largeRanges == 0 );
+    REQUIRE( std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }) );
+}
+
+TEST_CASE("Parallel: for each entity with zipped properties", "[entity_system][Parallel]")
+{
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, int> input(sys);
+    Property<MyEntity, int> output(sys);
+    auto entities = sys.add(500);
+    int i = 0;
+    for(auto const & entity : entities)
+    {
+        input[entity] = i++;
+    }
+    sys.erase(*entities.begin());
+
+    parallel_for_each(ParallelOptions(7), sys, [](const MyEntity & entity, const int & in, int & out)
+    {
+        out = 2 * in;
+    }, input, output);
+
+    for(auto const & entity : sys)
+    {
+        REQUIRE( output[entity] == 2 * input[entity] );
+    }
+
+    std::atomic<int> count(0);
+    parallel_for_each(sys, [&count](const MyEntity &) { ++count; });
+    REQUIRE( count == 499 );
+    REQUIRE( parallelThreads(ParallelOptions(1, 3)) >= 1 );
+}
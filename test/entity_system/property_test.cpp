@@ -8,8 +8,8 @@ using namespace ophidian::entity_system;
 MyEntity::MyEntity() : EntityBase()
 {}
 
-MyEntity::MyEntity(uint32_t id, EntitySystemBase *system) :
-    EntityBase(id, system)
+MyEntity::MyEntity(uint32_t id, uint32_t generation) :
+    EntityBase(id, generation)
 {}
 
 class MyDummyProperty {
@@ -184,3 +184,65 @@ TEST_CASE("Property: accessing property after erasing entity", "[entity_system][
 
 
 
+
+TEST_CASE("Property: rollback to a checkpoint", "[entity_system][Property]") {
+    EntitySystem<MyEntity> sys;
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    auto en3 = sys.add();
+    Property<MyEntity, int> prop(sys);
+    prop[en1] = 1;
+    prop[en2] = 2;
+    prop[en3] = 3;
+    REQUIRE(!prop.journaling());
+
+    prop.checkpoint();
+    REQUIRE(prop.journaling());
+    prop.set(en1, 10);
+    prop.set(en1, 100);
+    prop.set(en2, 20);
+
+    INFO("Nested checkpoints roll back independently");
+    prop.checkpoint();
+    prop.set(en3, 30);
+    prop.rollback();
+    REQUIRE(prop[en3] == 3);
+    REQUIRE(prop[en1] == 100);
+
+    prop.checkpoint();
+    prop.set(en3, 300);
+    prop.commit();
+
+    INFO("Erased entities are skipped");
+    sys.erase(en2);
+    prop.rollback();
+    REQUIRE(!prop.journaling());
+    REQUIRE(prop[en1] == 1);
+    REQUIRE(prop[en3] == 3);
+
+    prop.checkpoint();
+    prop.set(en1, 5);
+    prop.commit();
+    REQUIRE(!prop.journaling());
+    REQUIRE(prop[en1] == 5);
+}
+
+TEST_CASE("Property: only set() is journaled", "[entity_system][Property]") {
+    EntitySystem<MyEntity> sys;
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    Property<MyEntity, int> prop(sys);
+    prop[en1] = 1;
+    prop.checkpoint();
+    auto before = prop.memoryUsage().totalBytes();
+    for(int i = 0; i < 100; ++i)
+    {
+        REQUIRE(prop[en1] == 1);
+    }
+    REQUIRE(prop.memoryUsage().totalBytes() == before);
+    prop.set(en1, 2);
+    prop[en2] = 3;
+    prop.rollback();
+    REQUIRE(prop[en1] == 1);
+    REQUIRE(prop[en2] == 3);
+}
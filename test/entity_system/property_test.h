@@ -6,7 +6,7 @@
 class MyEntity : public ophidian::entity_system::EntityBase {
 public:
     MyEntity();
-    MyEntity(uint32_t id, ophidian::entity_system::EntitySystemBase * system);
+    MyEntity(uint32_t id, uint32_t generation);
 };
 
 #endif // PROPERTY_TEST_H
@@ -0,0 +1,202 @@
+#include "property_test.h"
+#include <catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <ophidian/entity_system/Aggregation.h>
+#include <ophidian/entity_system/PackedProperty.h>
+
+using namespace ophidian::entity_system;
+using ophidian::util::BinaryReader;
+using ophidian::util::BinaryWriter;
+
+namespace
+{
+class Whole : public EntityBase
+{
+public:
+    using EntityBase::EntityBase;
+};
+
+class Part : public EntityBase
+{
+public:
+    using EntityBase::EntityBase;
+};
+}
+
+TEST_CASE("Serialization: EntitySystem and Properties round trip", "[entity_system][Serialization]")
+{
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, double> weights(sys);
+    Property<MyEntity, std::string> names(sys);
+    PackedProperty<MyEntity, bool> flags(sys);
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 100; ++i)
+    {
+        entities.push_back(sys.add());
+        weights[entities.back()] = i * 0.25;
+        names[entities.back()] = std::string(i, 'a' + i % 26);
+        flags[entities.back()] = i % 7 == 0;
+    }
+    sys.erase(entities[10]);
+
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+    sys.save(writer);
+    weights.save(writer);
+    names.save(writer);
+    flags.save(writer);
+
+    EntitySystem<MyEntity> loaded;
+    Property<MyEntity, double> loadedWeights(loaded);
+    Property<MyEntity, std::string> loadedNames(loaded);
+    PackedProperty<MyEntity, bool> loadedFlags(loaded);
+    loaded.add();
+    BinaryReader reader(stream);
+    loaded.load(reader);
+    REQUIRE( loaded.size() == 99 );
+    REQUIRE( loadedWeights.size() == 99 );
+    loadedWeights.load(reader);
+    loadedNames.load(reader);
+    loadedFlags.load(reader);
+
+    REQUIRE( !loaded.valid(entities[10]) );
+    for(int i = 0; i < 100; ++i)
+    {
+        if(i == 10)
+        {
+            continue;
+        }
+        REQUIRE( loaded.valid(entities[i]) );
+        REQUIRE( loaded.id(entities[i]) == sys.id(entities[i]) );
+        REQUIRE( loadedWeights[entities[i]] == i * 0.25 );
+        REQUIRE( loadedNames[entities[i]] == std::string(i, 'a' + i % 26) );
+        REQUIRE( loadedFlags[entities[i]] == (i % 7 == 0) );
+    }
+    REQUIRE( loadedFlags.count(true) == 15 );
+
+    auto reused = loaded.add();
+    REQUIRE( reused != entities[10] );
+    REQUIRE( loadedWeights[reused] == 0.0 );
+}
+
+TEST_CASE("Serialization: Aggregation round trip", "[entity_system][Serialization]")
+{
+    EntitySystem<Whole> wholes;
+    EntitySystem<Part> parts;
+    Aggregation<Whole, Part> aggregation(wholes, parts);
+    auto whole1 = wholes.add();
+    auto whole2 = wholes.add();
+    std::vector<Part> created;
+    for(int i = 0; i < 6; ++i)
+    {
+        created.push_back(parts.add());
+        aggregation.addAssociation(i % 2 ? whole2 : whole1, created.back());
+    }
+
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+    wholes.save(writer);
+    parts.save(writer);
+    aggregation.save(writer);
+
+    EntitySystem<Whole> loadedWholes;
+    EntitySystem<Part> loadedParts;
+    Aggregation<Whole, Part> loadedAggregation(loadedWholes, loadedParts);
+    BinaryReader reader(stream);
+    loadedWholes.load(reader);
+    loadedParts.load(reader);
+    loadedAggregation.load(reader);
+
+    REQUIRE( loadedAggregation.numParts(whole1) == 3 );
+    REQUIRE( loadedAggregation.numParts(whole2) == 3 );
+    std::vector<Part> expected(aggregation.parts(whole2).begin(), aggregation.parts(whole2).end());
+    std::vector<Part> actual(loadedAggregation.parts(whole2).begin(), loadedAggregation.parts(whole2).end());
+    REQUIRE( actual == expected );
+    REQUIRE( loadedAggregation.whole(created[4]) == whole1 );
+
+    loadedAggregation.eraseAssociation(whole1, created[2]);
+    REQUIRE( loadedAggregation.numParts(whole1) == 2 );
+}
+
+TEST_CASE("Serialization: corrupted streams are rejected", "[entity_system][Serialization]")
+{
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, int> values(sys);
+    for(int i = 0; i < 10; ++i)
+    {
+        values[sys.add()] = i;
+    }
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+    sys.save(writer);
+    values.save(writer);
+    const std::string bytes = stream.str();
+
+    SECTION("flipped payload byte")
+    {
+        std::string corrupted = bytes;
+        corrupted[sizeof(ophidian::util::BinaryFormat::Header) + 3] ^= 0x10;
+        std::stringstream in(corrupted);
+        BinaryReader reader(in);
+        EntitySystem<MyEntity> loaded;
+        REQUIRE_THROWS_AS( loaded.load(reader), ophidian::util::BinaryChecksumMismatch );
+        REQUIRE( loaded.empty() );
+    }
+    SECTION("newer version")
+    {
+        std::string newer = bytes;
+        newer[4] = static_cast<char>(ophidian::util::BinaryFormat::kVersion + 1);
+        std::stringstream in(newer);
+        BinaryReader reader(in);
+        EntitySystem<MyEntity> loaded;
+        REQUIRE_THROWS_AS( loaded.load(reader), ophidian::util::UnsupportedBinaryVersion );
+    }
+    SECTION("truncated stream")
+    {
+        std::stringstream in(bytes.substr(0, bytes.size() - 4));
+        BinaryReader reader(in);
+        EntitySystem<MyEntity> loaded;
+        Property<MyEntity, int> loadedValues(loaded);
+        loaded.load(reader);
+        REQUIRE_THROWS_AS( loadedValues.load(reader), ophidian::util::InvalidBinaryFormat );
+    }
+    SECTION("count overflowing the block size")
+    {
+        // 2^61 + 10 Entities of 8 bytes wrap around to the 80 bytes of the block
+        REQUIRE( sizeof(MyEntity) == 8 );
+        std::string corrupted = bytes;
+        const std::uint64_t count = (std::uint64_t(1) << 61) + 10;
+        corrupted.replace(offsetof(ophidian::util::BinaryFormat::Header, count), sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+        std::stringstream in(corrupted);
+        BinaryReader reader(in);
+        EntitySystem<MyEntity> loaded;
+        REQUIRE_THROWS_AS( loaded.load(reader), ophidian::util::InvalidBinaryFormat );
+    }
+    SECTION("wrong value type")
+    {
+        std::stringstream in(bytes);
+        BinaryReader reader(in);
+        EntitySystem<MyEntity> loaded;
+        Property<MyEntity, double> loadedValues(loaded);
+        loaded.load(reader);
+        REQUIRE_THROWS_AS( loadedValues.load(reader), ophidian::util::InvalidBinaryFormat );
+    }
+}
+
+TEST_CASE("Serialization: string blocks with a corrupt count are rejected", "[entity_system][Serialization]")
+{
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+    writer.write(1, std::vector<std::string>{"a", "bc"});
+    std::string corrupted = stream.str();
+    const std::uint64_t count = std::uint64_t(1) << 61;
+    corrupted.replace(offsetof(ophidian::util::BinaryFormat::Header, count), sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+    std::stringstream in(corrupted);
+    BinaryReader reader(in);
+    std::vector<std::string> values;
+    REQUIRE_THROWS_AS( reader.read(1, values), ophidian::util::InvalidBinaryFormat );
+}
@@ -0,0 +1,129 @@
+#include "property_test.h"
+#include <catch.hpp>
+#include <cstdint>
+
+#include <ophidian/entity_system/SoAProperty.h>
+#include <ophidian/util/MemoryResource.h>
+
+using namespace ophidian::entity_system;
+
+namespace
+{
+struct Point3D
+{
+    double x, y, z;
+};
+}
+
+namespace ophidian
+{
+namespace entity_system
+{
+template <>
+struct SoAFields<Point3D>
+{
+    using Field = double;
+    static constexpr std::size_t fields = 3;
+    static Field get(const Point3D & point, std::size_t field)
+    {
+        return field == 0 ? point.x : (field == 1 ? point.y : point.z);
+    }
+    static Point3D make(const std::array<Field, fields> & coordinates)
+    {
+        return Point3D{coordinates[0], coordinates[1], coordinates[2]};
+    }
+};
+}
+}
+
+TEST_CASE("SoAProperty: fields are stored in separate aligned arrays", "[entity_system][SoAProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    SoAProperty<MyEntity, Point3D> prop(sys, Point3D{-1.0, -1.0, -1.0});
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 10; ++i)
+    {
+        entities.push_back(sys.add());
+    }
+    REQUIRE( prop.size() == 10 );
+    for(int i = 0; i < 10; ++i)
+    {
+        prop[entities[i]] = Point3D{double(i), 2.0 * i, 3.0 * i};
+    }
+    for(std::size_t field = 0; field < 3; ++field)
+    {
+        REQUIRE( reinterpret_cast<std::uintptr_t>(prop.data(field)) % 64 == 0 );
+    }
+    for(int i = 0; i < 10; ++i)
+    {
+        REQUIRE( prop.data(0)[sys.id(entities[i])] == i );
+        REQUIRE( prop.data(1)[sys.id(entities[i])] == 2.0 * i );
+        REQUIRE( prop.data(2)[sys.id(entities[i])] == 3.0 * i );
+    }
+
+    const SoAProperty<MyEntity, Point3D> & constProp = prop;
+    Point3D point = constProp[entities[4]];
+    REQUIRE( point.y == 8.0 );
+    prop[entities[5]].field(2) = 42.0;
+    point = prop[entities[5]];
+    REQUIRE( point.z == 42.0 );
+    REQUIRE( point.x == 5.0 );
+}
+
+TEST_CASE("SoAProperty: follows the EntitySystem lifecycle", "[entity_system][SoAProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    SoAProperty<MyEntity, Point3D> prop(sys);
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    auto en3 = sys.add();
+    auto en4 = sys.add();
+    prop[en1] = Point3D{1.0, 1.0, 1.0};
+    prop[en2] = Point3D{2.0, 2.0, 2.0};
+    prop[en3] = Point3D{3.0, 3.0, 3.0};
+    prop[en4] = Point3D{4.0, 4.0, 4.0};
+
+    sys.erase(en1);
+    REQUIRE( prop.size() == 3 );
+    REQUIRE( static_cast<Point3D>(prop[en4]).x == 4.0 );
+
+    auto en5 = sys.add();
+    REQUIRE( static_cast<Point3D>(prop[en5]).y == 0.0 );
+
+    std::vector<MyEntity> toErase{en2, en5};
+    sys.erase(toErase);
+    REQUIRE( prop.size() == 2 );
+    REQUIRE( static_cast<Point3D>(prop[en3]).z == 3.0 );
+    REQUIRE( static_cast<Point3D>(prop[en4]).z == 4.0 );
+
+    sys.clear();
+    REQUIRE( prop.empty() );
+}
+
+TEST_CASE("SoAProperty: rollback to a checkpoint", "[entity_system][SoAProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    SoAProperty<MyEntity, Point3D> prop(sys);
+    auto en1 = sys.add();
+    prop[en1] = Point3D{1.0, 2.0, 3.0};
+    prop.checkpoint();
+    prop.set(en1, Point3D{4.0, 5.0, 6.0});
+    prop[en1].field(0) = 7.0;
+    prop.rollback();
+    Point3D point = prop[en1];
+    REQUIRE( point.x == 1.0 );
+    REQUIRE( point.z == 3.0 );
+}
+
+TEST_CASE("SoAProperty: fields allocate from the resource of the EntitySystem", "[entity_system][SoAProperty]")
+{
+    ophidian::util::MonotonicArena arena;
+    EntitySystem<MyEntity> sys(&arena);
+    SoAProperty<MyEntity, Point3D> prop(sys);
+    sys.add(100);
+    REQUIRE( arena.allocatedBytes() >= 3 * 100 * sizeof(double) );
+    for(std::size_t field = 0; field < 3; ++field)
+    {
+        REQUIRE( reinterpret_cast<std::uintptr_t>(prop.data(field)) % 64 == 0 );
+    }
+}
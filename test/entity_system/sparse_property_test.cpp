@@ -0,0 +1,73 @@
+#include "property_test.h"
+#include <catch.hpp>
+
+#include <ophidian/entity_system/SparseProperty.h>
+
+using namespace ophidian::entity_system;
+
+TEST_CASE("SparseProperty: unset entities read the default value", "[entity_system][SparseProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    auto en1 = sys.add();
+    SparseProperty<MyEntity, int> prop(sys, 7);
+    REQUIRE( prop.empty() );
+    REQUIRE( !prop.has(en1) );
+    const SparseProperty<MyEntity, int> & constProp = prop;
+    REQUIRE( constProp[en1] == 7 );
+    REQUIRE( prop.empty() );
+}
+
+TEST_CASE("SparseProperty: iterate over set entities only", "[entity_system][SparseProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    SparseProperty<MyEntity, int> prop(sys);
+    std::vector<MyEntity> entities;
+    for(int i = 0; i < 100; ++i)
+    {
+        entities.push_back(sys.add());
+    }
+    prop[entities[3]] = 3;
+    prop[entities[42]] = 42;
+    prop[entities[99]] = 99;
+    REQUIRE( prop.size() == 3 );
+    REQUIRE( prop.has(entities[42]) );
+    int sum = 0;
+    for(auto const & entry : prop)
+    {
+        REQUIRE( entry.second == prop[entry.first] );
+        sum += entry.second;
+    }
+    REQUIRE( sum == 144 );
+
+    prop.reset(entities[3]);
+    REQUIRE( prop.size() == 2 );
+    REQUIRE( !prop.has(entities[3]) );
+    REQUIRE( prop[entities[99]] == 99 );
+}
+
+TEST_CASE("SparseProperty: follows the EntitySystem lifecycle", "[entity_system][SparseProperty]")
+{
+    EntitySystem<MyEntity> sys;
+    SparseProperty<MyEntity, int> prop(sys);
+    auto en1 = sys.add();
+    auto en2 = sys.add();
+    auto en3 = sys.add();
+    prop[en1] = 1;
+    prop[en3] = 3;
+
+    sys.erase(en1);
+    REQUIRE( prop.size() == 1 );
+    REQUIRE( prop[en3] == 3 );
+
+    INFO("A recycled id doesn't see the value of the erased entity");
+    auto en4 = sys.add();
+    REQUIRE( !prop.has(en4) );
+
+    std::vector<MyEntity> toErase{en2, en3};
+    sys.erase(toErase);
+    REQUIRE( prop.empty() );
+
+    prop[en4] = 4;
+    sys.clear();
+    REQUIRE( prop.empty() );
+}
@@ -103,6 +103,18 @@ public:
 } // namespace
   //
 
+TEST_CASE_METHOD(SitesWithPropertiesFixture, "Floorplan: Find sites by name.", "[floorplan]")
+{
+	Floorplan floorplan;
+	auto site1 = floorplan.add(Site(), name1, loc1);
+	const Floorplan & constFloorplan = floorplan;
+	REQUIRE(constFloorplan.find(name1) == site1);
+	REQUIRE(constFloorplan.find(name2) == Site());
+	floorplan.erase(site1);
+	REQUIRE(constFloorplan.find(name1) == Site());
+	REQUIRE(floorplan.sitesRange().empty());
+}
+
 TEST_CASE_METHOD(RowWithPropertiesFixture,"Floorplan: Add/Erase Rows.", "[floorplan]")
 {
 	Floorplan floorplan;
@@ -0,0 +1,57 @@
+#include "../circuit/netlist_builder.h"
+#include <catch.hpp>
+
+#include <ophidian/placement/Clustering.h>
+
+using namespace ophidian;
+
+namespace
+{
+class ClusteredPlacementFixture : public NetlistBuilder
+{
+public:
+    ClusteredPlacementFixture() :
+        NetlistBuilder(4),
+        placement(netlist)
+    {
+        // c0-c1 and c2-c3 are each connected by two Nets, and c1-c2 by one
+        connect({0, 1});
+        connect({0, 1});
+        connect({2, 3});
+        connect({2, 3});
+        connect({1, 2});
+        placement.placeCell(cells[0], util::LocationDbu(0.0, 0.0));
+        placement.placeCell(cells[1], util::LocationDbu(10.0, 20.0));
+        placement.placeCell(cells[2], util::LocationDbu(100.0, 100.0));
+        placement.placeCell(cells[3], util::LocationDbu(50.0, 50.0));
+        placement.fixLocation(cells[3]);
+    }
+
+    placement::Placement placement;
+};
+} // namespace
+
+TEST_CASE_METHOD(ClusteredPlacementFixture, "Clustering: placing clusters and their members", "[placement][Clustering]")
+{
+    circuit::Hypergraph hypergraph(netlist);
+    circuit::Clustering clustering(netlist, hypergraph, {}, circuit::ClusteringOptions(circuit::ClusteringOptions::Scheme::HeavyEdge));
+    REQUIRE( clustering.netlist().size(circuit::Cell()) == 2 );
+    auto movable = clustering.cluster(cells[0]);
+    auto fixed = clustering.cluster(cells[3]);
+    REQUIRE( clustering.cluster(cells[1]) == movable );
+    REQUIRE( clustering.cluster(cells[2]) == fixed );
+
+    placement::Placement clusters(clustering.netlist());
+    placement::placeClusters(clustering, placement, clusters);
+    REQUIRE( clusters.cellLocation(movable) == util::LocationDbu(5.0, 10.0) );
+    REQUIRE( !clusters.isFixed(movable) );
+    REQUIRE( clusters.cellLocation(fixed) == util::LocationDbu(50.0, 50.0) );
+    REQUIRE( clusters.isFixed(fixed) );
+
+    clusters.placeCell(movable, util::LocationDbu(30.0, 40.0));
+    placement::placeMembers(clustering, clusters, placement);
+    REQUIRE( placement.cellLocation(cells[0]) == util::LocationDbu(30.0, 40.0) );
+    REQUIRE( placement.cellLocation(cells[1]) == util::LocationDbu(30.0, 40.0) );
+    REQUIRE( placement.cellLocation(cells[2]) == util::LocationDbu(50.0, 50.0) );
+    REQUIRE( placement.cellLocation(cells[3]) == util::LocationDbu(50.0, 50.0) );
+}
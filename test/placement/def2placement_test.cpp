@@ -27,5 +27,8 @@ TEST_CASE_METHOD(Def2PlacementFixture, "Def2Placement: Test if def2placement map
     REQUIRE(placement.cellLocation(netlist.find(circuit::Cell(), "u3")) == util::LocationDbu(6840, 3420));
     REQUIRE(placement.cellLocation(netlist.find(circuit::Cell(), "u4")) == util::LocationDbu(12160, 6840));
     REQUIRE(placement.cellLocation(netlist.find(circuit::Cell(), "lcb1")) == util::LocationDbu(0, 10260));
+    REQUIRE(placement.isFixed(netlist.find(circuit::Cell(), "f1")));
+    REQUIRE(!placement.isFixed(netlist.find(circuit::Cell(), "u1")));
+    REQUIRE(placement.fixedCells().count(false) == 5);
 }
 
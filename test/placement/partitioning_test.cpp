@@ -0,0 +1,56 @@
+#include <catch.hpp>
+
+#include <ophidian/placement/Partitioning.h>
+
+using namespace ophidian::geometry;
+
+namespace
+{
+class AreaFixture
+{
+public:
+    AreaFixture() :
+        library(stdCells),
+        libraryMapping(netlist)
+    {
+        auto small = stdCells.add(ophidian::standard_cell::Cell(), "INVX1");
+        auto large = stdCells.add(ophidian::standard_cell::Cell(), "NAND2X1");
+        library.geometry(small, MultiBox({Box(Point(0, 0), Point(10, 20))}));
+        library.geometry(large, MultiBox({Box(Point(0, 0), Point(20, 20)), Box(Point(20, 0), Point(30, 10))}));
+
+        u1 = netlist.add(ophidian::circuit::Cell(), "u1");
+        u2 = netlist.add(ophidian::circuit::Cell(), "u2");
+        u3 = netlist.add(ophidian::circuit::Cell(), "u3");
+        libraryMapping.cellStdCell(u1, small);
+        libraryMapping.cellStdCell(u2, large);
+    }
+
+    ophidian::standard_cell::StandardCells stdCells;
+    ophidian::placement::Library library;
+    ophidian::circuit::Netlist netlist;
+    ophidian::circuit::LibraryMapping libraryMapping;
+    ophidian::circuit::Cell u1, u2, u3;
+};
+} // namespace
+
+TEST_CASE_METHOD(AreaFixture, "Partitioning: cell areas from the library", "[placement][Partitioning]")
+{
+    ophidian::circuit::Hypergraph hypergraph(netlist);
+    auto areas = ophidian::placement::cellAreas(hypergraph, library, libraryMapping);
+    REQUIRE( areas.size() == 3 );
+    REQUIRE( areas[hypergraph.index(u1)] == Approx(200.0) );
+    REQUIRE( areas[hypergraph.index(u2)] == Approx(500.0) );
+    REQUIRE( areas[hypergraph.index(u3)] == 0.0 );
+}
+
+TEST_CASE_METHOD(AreaFixture, "Partitioning: parts balanced by area", "[placement][Partitioning]")
+{
+    auto u4 = netlist.add(ophidian::circuit::Cell(), "u4");
+    libraryMapping.cellStdCell(u3, libraryMapping.cellStdCell(u2));
+    libraryMapping.cellStdCell(u4, libraryMapping.cellStdCell(u1));
+    ophidian::circuit::Hypergraph hypergraph(netlist);
+    auto partition = ophidian::placement::partition(hypergraph, library, libraryMapping, ophidian::circuit::PartitionOptions(2, 0.0));
+    REQUIRE( partition.weights[0] == Approx(700.0) );
+    REQUIRE( partition.weights[1] == Approx(700.0) );
+    REQUIRE( partition.parts[hypergraph.index(u1)] != partition.parts[hypergraph.index(u4)] );
+}
@@ -3,6 +3,7 @@
 #include <boost/geometry.hpp>
 
 #include <ophidian/placement/Placement.h>
+#include <ophidian/placement/PlacementOrdering.h>
 
 using namespace ophidian::placement;
 using namespace ophidian::circuit;
@@ -54,6 +55,57 @@ TEST_CASE_METHOD(NetlistFixture, "Placement: placing a cell", "[placement]") {
     REQUIRE(!(placedCell1Location == placedCell2Location));
 }
 
+TEST_CASE_METHOD(NetlistFixture, "Placement: cell coordinates as arrays", "[placement]") {
+    Placement placement(netlist);
+    placement.placeCell(cell1, ophidian::util::LocationDbu(10, 20));
+    placement.placeCell(cell2, ophidian::util::LocationDbu(30, 40));
+
+    using Fields = ophidian::entity_system::SoAFields<ophidian::util::LocationDbu>;
+    auto & locations = placement.cellLocations();
+    const double * xs = locations.data(Fields::X);
+    const double * ys = locations.data(Fields::Y);
+    REQUIRE(locations.size() == 2);
+    REQUIRE(xs[0] + xs[1] == 40.0);
+    REQUIRE(ys[0] + ys[1] == 60.0);
+}
+
+TEST_CASE_METHOD(NetlistFixture, "Placement: rolling back a tentative move", "[placement]") {
+    Placement placement(netlist);
+    placement.placeCell(cell1, ophidian::util::LocationDbu(10, 20));
+    placement.placeCell(cell2, ophidian::util::LocationDbu(30, 40));
+
+    placement.checkpoint();
+    placement.placeCell(cell1, ophidian::util::LocationDbu(50, 60));
+    placement.placeCell(cell2, ophidian::util::LocationDbu(70, 80));
+    placement.rollback();
+
+    REQUIRE(placement.cellLocation(cell1) == ophidian::util::LocationDbu(10, 20));
+    REQUIRE(placement.cellLocation(cell2) == ophidian::util::LocationDbu(30, 40));
+}
+
+TEST_CASE_METHOD(NetlistFixture, "Placement: draining moved cells", "[placement]") {
+    Placement placement(netlist);
+    auto consumer = placement.cellChanges().subscribe();
+    placement.placeCell(cell2, ophidian::util::LocationDbu(10, 20));
+    placement.placeCell(cell2, ophidian::util::LocationDbu(30, 40));
+
+    auto moved = placement.cellChanges().drain(consumer);
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved.front() == cell2);
+    REQUIRE(placement.cellChanges().drain(consumer).empty());
+}
+
+TEST_CASE_METHOD(NetlistFixture, "Placement: fixing cells", "[placement]") {
+    Placement placement(netlist);
+    REQUIRE(!placement.isFixed(cell1));
+    REQUIRE(placement.fixedCells().count(false) == 2);
+    placement.fixLocation(cell2);
+    REQUIRE(placement.isFixed(cell2));
+    REQUIRE(placement.fixedCells().count(true) == 1);
+    placement.fixLocation(cell2, false);
+    REQUIRE(!placement.isFixed(cell2));
+}
+
 TEST_CASE_METHOD(NetlistFixture, "Placement: placing an input pad", "[placement]") {
     Placement placement(netlist);
 
@@ -81,3 +133,24 @@ TEST_CASE_METHOD(NetlistFixture, "Placement: placing an output pad", "[placement
     REQUIRE(placement.outputPadLocation(output2) == output2Location);
     REQUIRE(placement.outputPadLocation(output1) != placement.outputPadLocation(output2));
 }
+
+TEST_CASE("Placement: hilbert order groups nearby cells", "[placement]") {
+    Netlist netlist;
+    std::vector<Cell> cells;
+    for(int index = 0; index < 4; ++index)
+    {
+        cells.push_back(netlist.add(Cell(), "cell" + std::to_string(index)));
+    }
+    Placement placement(netlist);
+    placement.placeCell(cells[0], ophidian::util::LocationDbu(0, 0));
+    placement.placeCell(cells[1], ophidian::util::LocationDbu(1000, 1000));
+    placement.placeCell(cells[2], ophidian::util::LocationDbu(10, 0));
+    placement.placeCell(cells[3], ophidian::util::LocationDbu(1000, 990));
+
+    netlist.permute(Cell(), hilbertOrder(placement));
+    std::vector<Cell> ordered(netlist.begin(Cell()), netlist.end(Cell()));
+    auto first = std::find(ordered.begin(), ordered.end(), cells[0]) - ordered.begin();
+    auto second = std::find(ordered.begin(), ordered.end(), cells[2]) - ordered.begin();
+    REQUIRE(std::abs(first - second) == 1);
+    REQUIRE(placement.cellLocation(cells[1]) == ophidian::util::LocationDbu(1000, 1000));
+}
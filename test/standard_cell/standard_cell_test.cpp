@@ -56,6 +56,18 @@ TEST_CASE_METHOD(StandardCellsFixture, "Standard cells: cell mapping", "[standar
 	REQUIRE (stdCells.size(Cell()) == 0);
 }
 
+TEST_CASE_METHOD(StandardCellsFixture, "Standard cells: finding a missing cell", "[standard_cell]")
+{
+	StandardCells stdCells;
+	auto cell1 = stdCells.add(Cell(), cell1Name);
+	const StandardCells & constCells = stdCells;
+
+	REQUIRE(constCells.find(Cell(), cell2Name) == Cell());
+	REQUIRE(constCells.find(Cell(), ophidian::util::StringView("cell1_X1").substr(0, 5)) == cell1);
+	REQUIRE(stdCells.memoryUsage().children.back().size == 1);
+	REQUIRE(stdCells.size(Cell()) == 1);
+}
+
 TEST_CASE_METHOD(StandardCellsFixture, "Standard cells: creating pins", "[standard_cell]")
 {
 	StandardCells stdCells;
@@ -107,3 +119,22 @@ TEST_CASE_METHOD(StandardCellsFixture, "Standard cells: associating pin to net",
 	REQUIRE(stdCells.pins(cell1).size() == 1);
 	REQUIRE(std::count(stdCells.pins(cell1).begin(), stdCells.pins(cell1).end(), pin1) == 1);
 }
+
+TEST_CASE_METHOD(StandardCellsFixture, "Standard cells: counting pins by direction", "[standard_cell]")
+{
+	StandardCells stdCells;
+	auto pin1 = stdCells.add(Pin(), pin1Name, pin1Direction);
+	auto pin2 = stdCells.add(Pin(), pin2Name, pin2Direction);
+	auto pin3 = stdCells.add(Pin(), "pin3", PinDirection::OUTPUT);
+
+	REQUIRE(stdCells.size(Pin(), PinDirection::INPUT) == 1);
+	REQUIRE(stdCells.size(Pin(), PinDirection::OUTPUT) == 2);
+	REQUIRE(stdCells.size(Pin(), PinDirection::INOUT) == 0);
+	REQUIRE(stdCells.direction(pin3) == PinDirection::OUTPUT);
+
+	std::vector<Pin> outputs;
+	stdCells.directions().forEach(PinDirection::OUTPUT, [&outputs](const Pin & pin) {
+		outputs.push_back(pin);
+	});
+	REQUIRE(outputs == std::vector<Pin>({pin2, pin3}));
+}
@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <cstdint>
+
+#include <ophidian/util/MemoryResource.h>
+#include <ophidian/entity_system/Property.h>
+#include <ophidian/entity_system/SparseProperty.h>
+
+using namespace ophidian::util;
+
+namespace
+{
+class CountingResource : public MemoryResource
+{
+public:
+    CountingResource() : allocations(0), deallocations(0) {}
+    void* allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return defaultResource()->allocate(bytes, alignment);
+    }
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations;
+        defaultResource()->deallocate(p, bytes, alignment);
+    }
+    int allocations;
+    int deallocations;
+};
+
+class MyEntity : public ophidian::entity_system::EntityBase
+{
+public:
+    using ophidian::entity_system::EntityBase::EntityBase;
+};
+}
+
+TEST_CASE("MemoryResource: monotonic arena releases everything at once", "[util][MemoryResource]")
+{
+    CountingResource upstream;
+    {
+        MonotonicArena arena(&upstream, 1024);
+        for(std::size_t alignment : {1, 8, 64, 256})
+        {
+            void* block = arena.allocate(100, alignment);
+            REQUIRE( reinterpret_cast<std::uintptr_t>(block) % alignment == 0 );
+        }
+        arena.allocate(10000, 8);
+        REQUIRE( arena.allocatedBytes() == 10400 );
+        REQUIRE( arena.reservedBytes() >= 10400 );
+        REQUIRE( upstream.allocations == 2 );
+        REQUIRE( upstream.deallocations == 0 );
+    }
+    REQUIRE( upstream.deallocations == 2 );
+}
+
+TEST_CASE("MemoryResource: huge page resource", "[util][MemoryResource]")
+{
+    CountingResource upstream;
+    HugePageResource resource(&upstream);
+    void* small = resource.allocate(4096, 8);
+    void* large = resource.allocate(3 * HugePageResource::kHugePageSize + 1, 64);
+    REQUIRE( reinterpret_cast<std::uintptr_t>(large) % 64 == 0 );
+    static_cast<char*>(large)[3 * HugePageResource::kHugePageSize] = 1;
+    resource.deallocate(large, 3 * HugePageResource::kHugePageSize + 1, 64);
+    resource.deallocate(small, 4096, 8);
+    REQUIRE( upstream.deallocations == upstream.allocations );
+}
+
+TEST_CASE("MemoryResource: EntitySystem and Properties allocate from the resource", "[util][MemoryResource]")
+{
+    CountingResource resource;
+    {
+        ophidian::entity_system::EntitySystem<MyEntity> sys(&resource);
+        ophidian::entity_system::Property<MyEntity, int> prop(sys);
+        REQUIRE( sys.resource() == &resource );
+        sys.add(100);
+        prop[*sys.begin()] = 42;
+        REQUIRE( resource.allocations >= 4 );
+        ophidian::entity_system::SparseProperty<MyEntity, int> sparse(sys);
+        auto allocations = resource.allocations;
+        sparse[*sys.begin()] = 42;
+        REQUIRE( resource.allocations > allocations );
+    }
+    REQUIRE( resource.deallocations == resource.allocations );
+}
@@ -0,0 +1,84 @@
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ophidian/util/MemoryUsage.h>
+#include <ophidian/entity_system/Property.h>
+#include <ophidian/entity_system/Aggregation.h>
+#include "../entity_system/property_test.h"
+
+using namespace ophidian::util;
+
+TEST_CASE("MemoryUsage: strings report their heap buffers", "[util][MemoryUsage]")
+{
+    std::string shortString("a");
+    std::string longString(1000, 'a');
+    REQUIRE( heapBytes(shortString) == 0 );
+    REQUIRE( heapBytes(longString) > 1000 );
+
+    std::vector<std::string> strings{shortString, longString};
+    auto usage = memoryUsage(strings);
+    REQUIRE( usage.size == 2 );
+    REQUIRE( usage.bytes == strings.capacity() * sizeof(std::string) + heapBytes(strings[1]) );
+}
+
+TEST_CASE("MemoryUsage: hash maps report buckets and nodes", "[util][MemoryUsage]")
+{
+    std::unordered_map<std::string, int> map;
+    for(int i = 0; i < 100; ++i)
+    {
+        map[std::to_string(i)] = i;
+    }
+    auto usage = memoryUsage(map);
+    REQUIRE( usage.size == 100 );
+    REQUIRE( usage.capacity == map.bucket_count() );
+    REQUIRE( usage.bytes >= map.bucket_count() * sizeof(void *) + 100 * sizeof(std::pair<const std::string, int>) );
+}
+
+TEST_CASE("MemoryUsage: reports are hierarchical", "[util][MemoryUsage]")
+{
+    using namespace ophidian::entity_system;
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, std::string> names(sys);
+    sys.reserve(64);
+    for(int i = 0; i < 10; ++i)
+    {
+        names[sys.add()] = std::string(100, 'x');
+    }
+
+    auto systemUsage = sys.memoryUsage();
+    REQUIRE( systemUsage.size == 10 );
+    REQUIRE( systemUsage.capacity == 64 );
+    REQUIRE( systemUsage.bytes == 64 * sizeof(MyEntity) );
+    REQUIRE( systemUsage.totalBytes() > systemUsage.bytes );
+
+    auto namesUsage = names.memoryUsage();
+    REQUIRE( namesUsage.size == 10 );
+    REQUIRE( namesUsage.bytes >= names.capacity() * sizeof(std::string) + 10 * 100 );
+
+    MemoryUsage report("report");
+    report.add("system", systemUsage).add("names", namesUsage);
+    REQUIRE( report.children.size() == 2 );
+    REQUIRE( report.children[1].name == "names" );
+    REQUIRE( report.totalBytes() == systemUsage.totalBytes() + namesUsage.totalBytes() );
+
+    std::ostringstream out;
+    out << report;
+    REQUIRE( out.str().find("report: " + std::to_string(report.totalBytes()) + " bytes") == 0 );
+    REQUIRE( out.str().find("\n  names: ") != std::string::npos );
+}
+
+TEST_CASE("MemoryUsage: journal entries are reported while a checkpoint is open", "[util][MemoryUsage]")
+{
+    using namespace ophidian::entity_system;
+    EntitySystem<MyEntity> sys;
+    Property<MyEntity, int> prop(sys);
+    auto en = sys.add();
+    auto before = prop.memoryUsage().totalBytes();
+    prop.checkpoint();
+    prop.set(en, 1);
+    REQUIRE( prop.memoryUsage().totalBytes() > before );
+    prop.commit();
+}
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+#include <string>
+
+#include <ophidian/util/StringPool.h>
+
+using namespace ophidian::util;
+
+TEST_CASE("StringPool: interning returns the same symbol for equal strings", "[util][StringPool]")
+{
+    StringPool pool;
+    REQUIRE( pool.size() == 0 );
+    auto a = pool.intern("u1:a");
+    auto o = pool.intern("u1:o");
+    REQUIRE( a != o );
+    REQUIRE( pool.intern(std::string("u1:a")) == a );
+    REQUIRE( pool.size() == 2 );
+    REQUIRE( pool.str(a) == "u1:a" );
+    REQUIRE( pool.view(o) == "u1:o" );
+}
+
+TEST_CASE("StringPool: find does not intern", "[util][StringPool]")
+{
+    StringPool pool;
+    auto empty = pool.intern("");
+    REQUIRE( pool.find("") == empty );
+    REQUIRE( pool.find("missing") == kInvalidSymbol );
+    REQUIRE( pool.size() == 1 );
+}
+
+TEST_CASE("StringPool: symbols survive growth", "[util][StringPool]")
+{
+    StringPool pool;
+    for(int i = 0; i < 10000; ++i)
+    {
+        REQUIRE( pool.intern("cell" + std::to_string(i)) == Symbol(i) );
+    }
+    REQUIRE( pool.size() == 10000 );
+    for(int i = 0; i < 10000; ++i)
+    {
+        REQUIRE( pool.find("cell" + std::to_string(i)) == Symbol(i) );
+        REQUIRE( pool.str(Symbol(i)) == "cell" + std::to_string(i) );
+    }
+    REQUIRE( pool.memoryUsage().totalBytes() > 10000 * sizeof(Symbol) );
+}
+
+TEST_CASE("StringPool: interning a view of the pool itself", "[util][StringPool]")
+{
+    StringPool pool;
+    auto long_ = pool.intern("a_string_that_will_be_copied");
+    for(int i = 0; i < 100; ++i)
+    {
+        pool.intern(pool.view(long_).substr(0, i % 28 + 1));
+    }
+    REQUIRE( pool.str(pool.find("a_string")) == "a_string" );
+}
+
+TEST_CASE("StringPool: frozen pools find every string", "[util][StringPool]")
+{
+    StringPool pool;
+    for(int i = 0; i < 50000; ++i)
+    {
+        pool.intern("u" + std::to_string(i) + ":o");
+    }
+    auto before = pool.memoryUsage().totalBytes();
+    pool.freeze();
+    REQUIRE( pool.frozen() == 50000 );
+    REQUIRE( pool.memoryUsage().totalBytes() < before );
+    for(int i = 0; i < 50000; ++i)
+    {
+        REQUIRE( pool.find("u" + std::to_string(i) + ":o") == Symbol(i) );
+    }
+    REQUIRE( pool.find("u50000:o") == kInvalidSymbol );
+    REQUIRE( pool.find("") == kInvalidSymbol );
+    REQUIRE( pool.intern("u42:o") == 42 );
+    REQUIRE( pool.size() == 50000 );
+}
+
+TEST_CASE("StringPool: strings interned after freezing", "[util][StringPool]")
+{
+    StringPool pool;
+    pool.freeze();
+    REQUIRE( pool.frozen() == 0 );
+    auto a = pool.intern("a");
+    auto b = pool.intern("b");
+    pool.freeze();
+    REQUIRE( pool.frozen() == 2 );
+    for(int i = 0; i < 1000; ++i)
+    {
+        REQUIRE( pool.intern("n" + std::to_string(i)) == Symbol(i + 2) );
+    }
+    REQUIRE( pool.find("a") == a );
+    REQUIRE( pool.find("b") == b );
+    REQUIRE( pool.find("n999") == 1001 );
+    pool.freeze();
+    REQUIRE( pool.frozen() == 1002 );
+    REQUIRE( pool.find("n999") == 1001 );
+    REQUIRE( pool.find("n1000") == kInvalidSymbol );
+}